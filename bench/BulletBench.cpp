@@ -0,0 +1,106 @@
+// Stress benchmark for projectiles: tens of thousands of bullets in flight in
+// a large maze, topped back up every tick like an automatic weapon. Compares
+// the old vector path (emplace_back, per-bullet std::round, erase-remove) with
+// BulletPool. Needs only the maze core, no SFML.
+//
+// Usage: bullet_bench [cols] [rows] [bullets] [ticks]
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "BulletPool.h"
+#include "Rng.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct VectorBullet {
+    float x, y;
+    float prevX, prevY;
+    int dirX, dirY;
+    float speed;
+    bool active;
+
+    VectorBullet(float px, float py, int dx, int dy, float s) : x(px), y(py), prevX(px), prevY(py), dirX(dx), dirY(dy), speed(s), active(true) {}
+};
+
+// Player::updateBullets before the pool. Its bounds check is left out: it
+// also killed bullets a little way into the left and top border walls, which
+// the pool treats like every other wall, and the fired counts are compared.
+static void updateVector(const MazeGrid& grid, std::vector<VectorBullet>& bullets, float deltaTime) {
+    for(auto& bullet : bullets) {
+        bullet.prevX = bullet.x;
+        bullet.prevY = bullet.y;
+        float step = bullet.speed * deltaTime;
+        int cx = static_cast<int>(std::round(bullet.x));
+        int cy = static_cast<int>(std::round(bullet.y));
+        float nextX = bullet.x + bullet.dirX * step;
+        float nextY = bullet.y + bullet.dirY * step;
+        int nextCx = static_cast<int>(std::round(nextX));
+        int nextCy = static_cast<int>(std::round(nextY));
+        if((nextCx != cx || nextCy != cy) && !grid.canMove(cx, cy, nextCx - cx, nextCy - cy)) {
+            bullet.active = false;
+            continue;
+        }
+        bullet.x = nextX;
+        bullet.y = nextY;
+    }
+    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](const VectorBullet& b) { return !b.active; }), bullets.end());
+}
+
+struct Shot {
+    int x, y, dir;
+};
+
+int main(int argc, char** argv) {
+    int cols = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int bulletCount = argc > 3 ? std::atoi(argv[3]) : 50000;
+    int ticks = argc > 4 ? std::atoi(argv[4]) : 1000;
+    const float speed = 30.0f;
+    const float deltaTime = 1.0f / 120;
+
+    MazeGrid grid(cols, rows);
+    MazeGenerator* generator = createMazeGenerator("backtracker", grid, 1234);
+    generator->run();
+    delete generator;
+
+    // Both paths fire the same shots in the same order.
+    std::vector<Shot> shots(1 << 16);
+    Rng rng(1234);
+    for(auto& s : shots) s = Shot{static_cast<int>(rng.below(cols)), static_cast<int>(rng.below(rows)), static_cast<int>(rng.below(4))};
+
+    typedef std::chrono::steady_clock Clock;
+    std::vector<VectorBullet> vectorBullets;
+    BulletPool pool(bulletCount);
+    size_t vectorShot = 0, poolShot = 0;
+    long long vectorFired = 0, poolFired = 0;
+
+    Clock::time_point t0 = Clock::now();
+    for(int t = 0; t < ticks; ++t) {
+        while(static_cast<int>(vectorBullets.size()) < bulletCount) {
+            const Shot& s = shots[vectorShot++ & (shots.size() - 1)];
+            vectorBullets.emplace_back(static_cast<float>(s.x), static_cast<float>(s.y), MazeGrid::DX[s.dir], MazeGrid::DY[s.dir], speed);
+            ++vectorFired;
+        }
+        updateVector(grid, vectorBullets, deltaTime);
+    }
+    Clock::time_point t1 = Clock::now();
+    for(int t = 0; t < ticks; ++t) {
+        while(static_cast<int>(pool.size()) < bulletCount) {
+            const Shot& s = shots[poolShot++ & (shots.size() - 1)];
+            pool.spawn(static_cast<float>(s.x), static_cast<float>(s.y), MazeGrid::DX[s.dir], MazeGrid::DY[s.dir], speed);
+            ++poolFired;
+        }
+        pool.update(grid, deltaTime);
+    }
+    Clock::time_point t2 = Clock::now();
+
+    auto usPerTick = [ticks](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count() / ticks; };
+    std::cout << cols << "x" << rows << " cells, " << bulletCount << " bullets in flight, " << ticks << " ticks\n";
+    std::cout << "vector + erase-remove: " << usPerTick(t1 - t0) << " us/tick (" << vectorFired << " fired)\n";
+    std::cout << "bullet pool:           " << usPerTick(t2 - t1) << " us/tick (" << poolFired << " fired)\n";
+    return vectorFired == poolFired ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// Stress benchmark for entity collision queries: bullets x enemies nested loop
+// vs the per-cell CellIndex, with thousands of both wandering a large maze.
+// Needs only the maze core, no SFML.
+//
+// Usage: collision_bench [cols] [rows] [enemies] [bullets] [frames]
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "CellIndex.h"
+#include "Rng.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+struct Body {
+    int x, y, dir;
+};
+
+static void wander(const MazeGrid& grid, Rng& rng, Body& b) {
+    int dir = static_cast<int>(rng.below(4));
+    if(!grid.hasWall(grid.index(b.x, b.y), dir)) {
+        b.x += MazeGrid::DX[dir];
+        b.y += MazeGrid::DY[dir];
+    }
+}
+
+static void fly(const MazeGrid& grid, Rng& rng, Body& b) {
+    if(grid.hasWall(grid.index(b.x, b.y), b.dir)) {
+        b.x = static_cast<int>(rng.below(grid.getCols()));
+        b.y = static_cast<int>(rng.below(grid.getRows()));
+        b.dir = static_cast<int>(rng.below(4));
+        return;
+    }
+    b.x += MazeGrid::DX[b.dir];
+    b.y += MazeGrid::DY[b.dir];
+}
+
+int main(int argc, char** argv) {
+    int cols = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int enemyCount = argc > 3 ? std::atoi(argv[3]) : 5000;
+    int bulletCount = argc > 4 ? std::atoi(argv[4]) : 5000;
+    int frames = argc > 5 ? std::atoi(argv[5]) : 100;
+
+    MazeGrid grid(cols, rows);
+    MazeGenerator* generator = createMazeGenerator("backtracker", grid, 1234);
+    generator->run();
+    delete generator;
+
+    Rng rng(1234);
+    std::vector<Body> enemies(enemyCount), bullets(bulletCount);
+    CellIndex index(cols, rows);
+    for(int i = 0; i < enemyCount; ++i) {
+        enemies[i] = Body{static_cast<int>(rng.below(cols)), static_cast<int>(rng.below(rows)), 0};
+        index.update(i, enemies[i].x, enemies[i].y);
+    }
+    for(auto& b : bullets) b = Body{static_cast<int>(rng.below(cols)), static_cast<int>(rng.below(rows)), static_cast<int>(rng.below(4))};
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration naiveTime{}, indexedTime{}, updateTime{};
+    long long naiveHits = 0, indexedHits = 0;
+
+    for(int f = 0; f < frames; ++f) {
+        Clock::time_point t0 = Clock::now();
+        for(int i = 0; i < enemyCount; ++i) {
+            wander(grid, rng, enemies[i]);
+            index.update(i, enemies[i].x, enemies[i].y);
+        }
+        for(auto& b : bullets) fly(grid, rng, b);
+        Clock::time_point t1 = Clock::now();
+
+        for(const auto& b : bullets) {
+            for(const auto& e : enemies) {
+                if(b.x == e.x && b.y == e.y) {
+                    ++naiveHits;
+                    break;
+                }
+            }
+        }
+        Clock::time_point t2 = Clock::now();
+
+        for(const auto& b : bullets) {
+            if(index.first(b.x, b.y) != CellIndex::NONE) ++indexedHits;
+        }
+        Clock::time_point t3 = Clock::now();
+
+        updateTime += t1 - t0;
+        naiveTime += t2 - t1;
+        indexedTime += t3 - t2;
+    }
+
+    auto msPerFrame = [frames](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count() / frames; };
+    std::cout << cols << "x" << rows << " cells, " << enemyCount << " enemies, " << bulletCount << " bullets, " << frames << " frames\n";
+    std::cout << "move + index update: " << msPerFrame(updateTime) << " ms/frame\n";
+    std::cout << "nested loop:         " << msPerFrame(naiveTime) << " ms/frame (" << naiveHits << " hits)\n";
+    std::cout << "cell index:          " << msPerFrame(indexedTime) << " ms/frame (" << indexedHits << " hits)\n";
+    return naiveHits == indexedHits ? 0 : 1;
+}
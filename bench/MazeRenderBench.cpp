@@ -0,0 +1,51 @@
+// Frame-time benchmark: per-cell RectangleShape drawing vs the batched maze mesh,
+// both for a finished maze and for animated generation (5 steps per frame).
+//
+// Usage: maze_render_bench [cols] [rows] [cellSize] [frames]
+
+#include "Maze.h"
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iostream>
+
+static float timeFrames(sf::RenderWindow& window, Maze& maze, bool batched, int frames, int stepsPerFrame = 0) {
+    sf::Clock clock;
+    for(int i = 0; i < frames; ++i) {
+        sf::Event event;
+        while(window.pollEvent(event)) {}
+        for(int s = 0; s < stepsPerFrame; ++s) maze.step();
+        window.clear(sf::Color(10, 10, 20));
+        if(batched) maze.draw(window);
+        else maze.drawCells(window);
+        window.display();
+    }
+    return clock.getElapsedTime().asSeconds() * 1000.0f / frames;
+}
+
+int main(int argc, char** argv) {
+    int cols = argc > 1 ? std::atoi(argv[1]) : 300;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 200;
+    int cellSize = argc > 3 ? std::atoi(argv[3]) : 4;
+    int frames = argc > 4 ? std::atoi(argv[4]) : 120;
+
+    sf::RenderWindow window(sf::VideoMode(cols * cellSize + 2, rows * cellSize + 2), "Maze render bench");
+    window.setVerticalSyncEnabled(false);
+
+    Maze animatedCells(cols, rows, cellSize, 1234);
+    float genPerCell = timeFrames(window, animatedCells, false, frames, 5);
+    Maze animatedBatched(cols, rows, cellSize, 1234);
+    animatedBatched.draw(window);
+    float genBatched = timeFrames(window, animatedBatched, true, frames, 5);
+
+    Maze maze(cols, rows, cellSize, 1234);
+    while(maze.isGenerating()) maze.step();
+    float perCell = timeFrames(window, maze, false, frames);
+    float batched = timeFrames(window, maze, true, frames);
+
+    std::cout << cols << "x" << rows << " cells, " << frames << " frames\n";
+    std::cout << "generating, per-cell:    " << genPerCell << " ms/frame\n";
+    std::cout << "generating, incremental: " << genBatched << " ms/frame\n";
+    std::cout << "finished, per-cell:      " << perCell << " ms/frame\n";
+    std::cout << "finished, batched:       " << batched << " ms/frame\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Long-range pathfinding on a huge maze: a flat breadth-first search per
+// query vs PathHierarchy (HPA*), checking that both find routes of the same
+// length and that refining the HPA* route walks exactly that many cells. Then
+// opens random walls and compares an incremental rebuild with a full one.
+// Last, many starts routed to a few shared goals: one findRoute() each vs a
+// PathQueue batch on 1 and on every hardware thread, checking the lengths
+// agree. Needs only the maze core, no SFML.
+//
+// Usage: path_bench [cols] [rows] [queries] [openedWalls] [clusterSize] [batchStarts]
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "PathHierarchy.h"
+#include "PathQueue.h"
+#include "Rng.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Steps from start to goal, stopping as soon as the goal is reached.
+static int flatSearch(const MazeGrid& grid, size_t start, size_t goal, std::vector<int>& distances, std::vector<size_t>& queue) {
+    for(size_t cell : queue) distances[cell] = -1;
+    queue.clear();
+    distances[start] = 0;
+    queue.push_back(start);
+    for(size_t head = 0; head < queue.size(); ++head) {
+        size_t cell = queue[head];
+        if(cell == goal) return distances[cell];
+        for(int dir = 0; dir < 4; ++dir) {
+            if(grid.hasWall(cell, dir)) continue;
+            size_t next = grid.neighbor(cell, dir);
+            if(distances[next] >= 0) continue;
+            distances[next] = distances[cell] + 1;
+            queue.push_back(next);
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    int cols = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 200;
+    int openedWalls = argc > 4 ? std::atoi(argv[4]) : 1000;
+    int clusterSize = argc > 5 ? std::atoi(argv[5]) : PathHierarchy::DEFAULT_CLUSTER_SIZE;
+    int batchStarts = argc > 6 ? std::atoi(argv[6]) : 2000;
+
+    MazeGrid grid(cols, rows);
+    MazeGenerator* generator = createMazeGenerator("backtracker", grid, 1234);
+    generator->run();
+    delete generator;
+
+    typedef std::chrono::steady_clock Clock;
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    PathHierarchy hierarchy(cols, rows, clusterSize);
+    Clock::time_point t0 = Clock::now();
+    hierarchy.build(grid);
+    Clock::duration buildTime = Clock::now() - t0;
+    std::cout << cols << "x" << rows << " cells, " << clusterSize << "x" << clusterSize << " clusters, " << hierarchy.getNodeCount() << " entrance nodes\n";
+    std::cout << "build:       " << ms(buildTime) << " ms\n";
+
+    Rng rng(1234);
+    std::vector<int> distances(grid.size(), -1);
+    std::vector<size_t> queue, waypoints, cells;
+    int mismatches = 0;
+    auto runQueries = [&](const char* label) {
+        Clock::duration flatTime{}, routeTime{}, refineTime{};
+        long long steps = 0;
+        for(int q = 0; q < queries; ++q) {
+            int sx = static_cast<int>(rng.below(cols)), sy = static_cast<int>(rng.below(rows));
+            int gx = static_cast<int>(rng.below(cols)), gy = static_cast<int>(rng.below(rows));
+            Clock::time_point a = Clock::now();
+            int flat = flatSearch(grid, grid.index(sx, sy), grid.index(gx, gy), distances, queue);
+            Clock::time_point b = Clock::now();
+            int route = hierarchy.findRoute(grid, sx, sy, gx, gy, waypoints);
+            Clock::time_point c = Clock::now();
+            cells.clear();
+            bool walked = hierarchy.refine(grid, grid.index(sx, sy), waypoints, cells);
+            Clock::time_point d = Clock::now();
+            flatTime += b - a;
+            routeTime += c - b;
+            refineTime += d - c;
+            steps += flat;
+            if(flat != route || !walked || static_cast<int>(cells.size()) != route) ++mismatches;
+        }
+        std::cout << label << " (" << queries << " queries, mean route " << steps / (queries > 0 ? queries : 1) << " steps)\n";
+        std::cout << "  flat search: " << ms(flatTime) / queries << " ms/query\n";
+        std::cout << "  hpa* route:  " << ms(routeTime) / queries << " ms/query\n";
+        std::cout << "  refine:      " << ms(refineTime) / queries << " ms/query\n";
+    };
+    runQueries("perfect maze");
+
+    // Opening walls adds loops; every opened wall invalidates the clusters
+    // around it.
+    for(int i = 0; i < openedWalls; ++i) {
+        int x = static_cast<int>(rng.below(cols - 1));
+        int y = static_cast<int>(rng.below(rows - 1));
+        int dir = rng.below(2) ? 1 : 2;
+        grid.removeWall(grid.index(x, y), dir);
+        hierarchy.invalidate(x, y);
+    }
+    t0 = Clock::now();
+    int rebuilt = hierarchy.update(grid);
+    Clock::duration updateTime = Clock::now() - t0;
+    std::cout << "opened " << openedWalls << " walls: incremental rebuild of " << rebuilt << " clusters " << ms(updateTime) << " ms (full build " << ms(buildTime) << " ms)\n";
+    runQueries("with loops");
+
+    // Starts within a few clusters of their goal, like hunters around the
+    // player; 4 goals.
+    std::vector<size_t> starts, goals;
+    for(int i = 0; i < batchStarts; ++i) {
+        size_t goal = grid.index(cols / 5 * (1 + i % 4), rows / 2);
+        int sx = std::min(cols - 1, std::max(0, grid.cellX(goal) + static_cast<int>(rng.below(8 * clusterSize)) - 4 * clusterSize));
+        int sy = std::min(rows - 1, std::max(0, grid.cellY(goal) + static_cast<int>(rng.below(8 * clusterSize)) - 4 * clusterSize));
+        starts.push_back(grid.index(sx, sy));
+        goals.push_back(goal);
+    }
+    std::vector<int> lengths(starts.size());
+    t0 = Clock::now();
+    for(size_t i = 0; i < starts.size(); ++i) {
+        lengths[i] = hierarchy.findRoute(grid, grid.cellX(starts[i]), grid.cellY(starts[i]), grid.cellX(goals[i]), grid.cellY(goals[i]), waypoints);
+    }
+    Clock::duration serialTime = Clock::now() - t0;
+    std::cout << "batch of " << batchStarts << " starts to 4 goals\n";
+    std::cout << "  findRoute each:  " << ms(serialTime) << " ms\n";
+    unsigned threadCounts[] = { 1, 0 };
+    for(unsigned threadCount : threadCounts) {
+        PathQueue pathQueue(threadCount);
+        for(size_t i = 0; i < starts.size(); ++i) pathQueue.request(static_cast<int>(i), starts[i], goals[i]);
+        t0 = Clock::now();
+        pathQueue.submit(hierarchy, grid);
+        const std::vector<PathQueue::Result>& results = pathQueue.collect();
+        Clock::duration batchTime = Clock::now() - t0;
+        for(const PathQueue::Result& result : results) {
+            if(result.length != lengths[result.slot]) ++mismatches;
+        }
+        std::cout << "  path queue, " << pathQueue.getThreadCount() << " thread" << (pathQueue.getThreadCount() == 1 ? ": " : "s: ") << ms(batchTime) << " ms\n";
+    }
+
+    if(mismatches == 0) std::cout << "all routes match the flat search and findRoute\n";
+    else std::cout << "route mismatches: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
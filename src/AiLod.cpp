@@ -0,0 +1,67 @@
+#include "AiLod.h"
+#include "RangeKernels.h"
+#include <algorithm>
+
+const AiLod::Config AiLod::DEFAULT_CONFIG = { 12.0f, 32.0f, 4, 30 };
+
+AiLod::AiLod(const Config& config_) : minNearRadius(0), lastReassign(0), stale(true), stats() {
+    setConfig(config_);
+}
+
+void AiLod::setConfig(const Config& config_) {
+    config = config_;
+    config.midInterval = std::max(1, config.midInterval);
+    config.reassignTicks = std::max(1, config.reassignTicks);
+    stale = true;
+}
+
+void AiLod::clear() {
+    for(std::vector<int>& tier : tiers) tier.clear();
+    slotTiers.clear();
+    slotPositions.clear();
+    stale = true;
+}
+
+void AiLod::moveSlot(int from, int to) {
+    if(from >= static_cast<int>(slotTiers.size()) || slotTiers[from] < 0) return;
+    int tier = slotTiers[from];
+    int position = slotPositions[from];
+    tiers[tier][position] = to;
+    slotTiers[from] = -1;
+    if(to < 0) return;
+    slotTiers[to] = static_cast<signed char>(tier);
+    slotPositions[to] = position;
+}
+
+void AiLod::reassign(EnemyStore& enemies, float px, float py, unsigned long long tickCount, float tickSeconds) {
+    // Far enemies stood still since the last reassignment; their hunts run
+    // down by the time that passed.
+    float elapsed = (tickCount - lastReassign) * tickSeconds;
+    for(int i : tiers[FAR]) {
+        if(i < 0 || !enemies.isAlive(i) || !enemies.isHunting(i)) continue;
+        enemies.endHuntTick(i, elapsed);
+        ++stats.updated[FAR];
+    }
+
+    std::size_t n = enemies.size();
+    float nearRadius = std::max(config.nearRadius, minNearRadius);
+    float midRadius = std::max(config.midRadius, nearRadius);
+    nearMask.resize(RangeKernels::maskWords(n));
+    midMask.resize(RangeKernels::maskWords(n));
+    RangeKernels::withinRadius(enemies.getXs(), enemies.getYs(), n, px, py, nearRadius, nearMask.data());
+    RangeKernels::withinRadius(enemies.getXs(), enemies.getYs(), n, px, py, midRadius, midMask.data());
+    for(std::vector<int>& tier : tiers) tier.clear();
+    slotTiers.assign(n, -1);
+    slotPositions.resize(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!enemies.isAlive(i)) continue;
+        std::uint32_t bit = 1u << (i % 32);
+        Tier tier = (nearMask[i / 32] & bit) ? NEAR : (midMask[i / 32] & bit) ? MID : FAR;
+        slotTiers[i] = static_cast<signed char>(tier);
+        slotPositions[i] = static_cast<int>(tiers[tier].size());
+        tiers[tier].push_back(static_cast<int>(i));
+    }
+    for(int t = 0; t < TIER_COUNT; ++t) stats.counts[t] = static_cast<int>(tiers[t].size());
+    lastReassign = tickCount;
+    stale = false;
+}
@@ -0,0 +1,109 @@
+#ifndef AILOD_H
+#define AILOD_H
+
+#include "EnemyStore.h"
+#include "Profiler.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Enemy AI level of detail. Every reassignTicks ticks the enemies are sorted
+// into tiers by their distance to the player, using the batch range kernels.
+// Near enemies are updated every tick; mid-range ones every midInterval
+// ticks with a time step to match, staggered so each tick takes an even
+// share; far ones are frozen, and only their hunt timers run down at each
+// reassignment. Between reassignments the per-tick cost follows the near
+// and mid-range populations, not the enemy count. No SFML dependency.
+class AiLod {
+public:
+    enum Tier { NEAR, MID, FAR, TIER_COUNT };
+
+    struct Config {
+        // Tier boundaries in cells from the player. nearRadius is raised to
+        // the largest detection radius plus MARGIN, so an enemy that could
+        // detect the player before the next reassignment is never throttled.
+        float nearRadius, midRadius;
+        // Ticks between updates of a mid-range enemy. Keep the step it
+        // takes (speed * midInterval / TICK_RATE) under half a cell.
+        int midInterval;
+        int reassignTicks;
+    };
+    static const Config DEFAULT_CONFIG;
+    // Cells the player and an enemy can close between reassignments.
+    static constexpr float MARGIN = 4.0f;
+
+    struct Stats {
+        int counts[TIER_COUNT];  // enemies per tier at the last reassignment
+        int updated[TIER_COUNT]; // enemies updated this tick (far: timers advanced)
+    };
+
+private:
+    Config config;
+    float minNearRadius;
+    std::vector<int> tiers[TIER_COUNT]; // enemy slots; -1 once removed
+    // Where each slot sits in tiers, so moveSlot() is O(1); tier -1 for
+    // slots in no list.
+    std::vector<signed char> slotTiers;
+    std::vector<int> slotPositions;
+    std::vector<std::uint32_t> nearMask, midMask;
+    unsigned long long lastReassign;
+    bool stale;
+    Stats stats;
+
+public:
+    explicit AiLod(const Config& config_ = DEFAULT_CONFIG);
+
+    void setConfig(const Config& config_);
+    const Config& getConfig() const { return config; }
+    // Largest detection radius among the enemies; bounds nearRadius.
+    void setDetectionRadius(float radius) { minNearRadius = radius + MARGIN; stale = true; }
+    // Forgets every enemy, e.g. before spawning; the next tick reassigns.
+    void clear();
+    // Enemy slot from now lives in slot to (to -1: removed). Remove the
+    // enemy in slot to before moving another one into it.
+    void moveSlot(int from, int to);
+
+    // Runs one tick: reassigns tiers when due, then calls update(i,
+    // deltaTime) for every near enemy and for this tick's share of the
+    // mid-range ones. Each tier's work is timed in its own profiler section
+    // (the reassignment counts as far).
+    template<class Update>
+    void tick(EnemyStore& enemies, float px, float py, unsigned long long tickCount, float tickSeconds, Update update);
+
+    const Stats& getStats() const { return stats; }
+    const std::vector<int>& getTier(Tier tier) const { return tiers[tier]; }
+
+private:
+    void reassign(EnemyStore& enemies, float px, float py, unsigned long long tickCount, float tickSeconds);
+};
+
+template<class Update>
+void AiLod::tick(EnemyStore& enemies, float px, float py, unsigned long long tickCount, float tickSeconds, Update update) {
+    {
+        PROFILE_SCOPE(Profiler::ENEMIES_FAR);
+        stats.updated[FAR] = 0;
+        if(stale || tickCount - lastReassign >= static_cast<unsigned long long>(config.reassignTicks)) reassign(enemies, px, py, tickCount, tickSeconds);
+    }
+    {
+        PROFILE_SCOPE(Profiler::ENEMIES_NEAR);
+        stats.updated[NEAR] = 0;
+        for(int i : tiers[NEAR]) {
+            if(i < 0) continue;
+            update(static_cast<std::size_t>(i), tickSeconds);
+            ++stats.updated[NEAR];
+        }
+    }
+    {
+        PROFILE_SCOPE(Profiler::ENEMIES_MID);
+        stats.updated[MID] = 0;
+        const std::vector<int>& mid = tiers[MID];
+        std::size_t interval = static_cast<std::size_t>(config.midInterval);
+        for(std::size_t k = (interval - tickCount % interval) % interval; k < mid.size(); k += interval) {
+            if(mid[k] < 0) continue;
+            update(static_cast<std::size_t>(mid[k]), tickSeconds * config.midInterval);
+            ++stats.updated[MID];
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include "BulletPool.h"
+#include <cmath>
+
+BulletPool::BulletPool(std::size_t capacity)
+    : slots(capacity), live(capacity), freeList(capacity), liveCount(0), freeCount(0) {
+    clear();
+}
+
+void BulletPool::clear() {
+    liveCount = 0;
+    freeCount = slots.size();
+    // Lowest slots on top of the stack, so a small volley stays in a few
+    // cache lines.
+    for(std::size_t i = 0; i < freeCount; ++i) freeList[i] = static_cast<std::uint32_t>(freeCount - 1 - i);
+}
+
+bool BulletPool::spawn(float x, float y, int dirX, int dirY, float speed) {
+    if(freeCount == 0) return false;
+    std::uint32_t id = freeList[--freeCount];
+    Bullet& b = slots[id];
+    b.x = b.prevX = x;
+    b.y = b.prevY = y;
+    b.dirX = dirX;
+    b.dirY = dirY;
+    b.dir = dirY < 0 ? 0 : dirX > 0 ? 1 : dirY > 0 ? 2 : 3;
+    b.cellX = static_cast<int>(std::round(x));
+    b.cellY = static_cast<int>(std::round(y));
+    b.speed = speed;
+    b.active = true;
+    live[liveCount++] = id;
+    return true;
+}
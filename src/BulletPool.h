@@ -0,0 +1,115 @@
+#ifndef BULLETPOOL_H
+#define BULLETPOOL_H
+
+#include "MazeGrid.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+struct Bullet {
+    float x, y;
+    float prevX, prevY; // position at the start of the last tick, for interpolation
+    int dirX, dirY;
+    int dir;            // wall direction of (dirX, dirY), see MazeGrid
+    int cellX, cellY;   // cell the bullet is in (nearest center)
+    float speed;        // cells per second
+    bool active;
+};
+
+// Bullets in a fixed number of slots allocated up front. Free slots are kept
+// on a stack and live slots in a dense list, so firing and expiring never
+// allocate and an update walks only the live bullets. Movement is swept: a
+// bullet visits every cell it passes through in a tick, in order, and stops
+// at the first wall or hit, so no speed or tick rate lets it tunnel. No SFML
+// dependency.
+class BulletPool {
+private:
+    // Smallest float above 0.5. A bullet exactly on a boundary belongs to
+    // the cell std::round gives it, rounding halves away from zero: the next
+    // cell when moving right or down (or out of column / row 0), otherwise
+    // its current one.
+    static constexpr float JUST_PAST_HALF = 0x1.000002p-1f;
+
+    std::vector<Bullet> slots;
+    std::vector<std::uint32_t> live;     // liveCount used
+    std::vector<std::uint32_t> freeList; // freeCount used
+    std::size_t liveCount, freeCount;
+
+    template<class HitTest>
+    static void sweep(const MazeGrid& grid, Bullet& b, float deltaTime, HitTest& hitTest);
+
+public:
+    explicit BulletPool(std::size_t capacity);
+
+    std::size_t capacity() const { return slots.size(); }
+    // Bullets in flight, in firing order.
+    std::size_t size() const { return liveCount; }
+    Bullet& operator[](std::size_t i) { return slots[live[i]]; }
+    const Bullet& operator[](std::size_t i) const { return slots[live[i]]; }
+
+    // Returns false, firing nothing, when every slot is in use. (dirX, dirY)
+    // is one of the four unit steps.
+    bool spawn(float x, float y, int dirX, int dirY, float speed);
+    void clear();
+
+    // Moves every bullet deltaTime seconds and kills it at the first wall or
+    // hit in its way, then frees the dead slots. hitTest(cellX, cellY) is
+    // asked for each cell a bullet occupies during the tick, starting with
+    // the one it was in, and returns true if something there stops it. It
+    // may change what later cells report (e.g. remove a killed enemy).
+    template<class HitTest>
+    void update(const MazeGrid& grid, float deltaTime, HitTest hitTest);
+    void update(const MazeGrid& grid, float deltaTime) {
+        update(grid, deltaTime, [](int, int) { return false; });
+    }
+};
+
+// Bullets fly along one axis, so the only cell boundaries crossed are the
+// ones ahead on that axis, halfway between centres. advance is how far past
+// its cell's centre the bullet is.
+template<class HitTest>
+inline void BulletPool::sweep(const MazeGrid& grid, Bullet& b, float deltaTime, HitTest& hitTest) {
+    b.prevX = b.x;
+    b.prevY = b.y;
+    if(hitTest(b.cellX, b.cellY)) {
+        b.active = false;
+        return;
+    }
+    float step = b.speed * deltaTime;
+    b.x += b.dirX * step;
+    b.y += b.dirY * step;
+    float advance = (b.x - b.cellX) * b.dirX + (b.y - b.cellY) * b.dirY;
+    bool tieCrosses = b.dirX + b.dirY > 0 || b.cellX * b.dirX + b.cellY * b.dirY == 0;
+    float boundary = tieCrosses ? 0.5f : JUST_PAST_HALF;
+    for(; advance >= boundary; advance -= 1.0f) {
+        if(grid.hasWall(grid.index(b.cellX, b.cellY), b.dir)) {
+            b.active = false;
+            return;
+        }
+        b.cellX += b.dirX;
+        b.cellY += b.dirY;
+        if(!grid.inBounds(b.cellX, b.cellY) || hitTest(b.cellX, b.cellY)) {
+            b.active = false;
+            return;
+        }
+    }
+}
+
+// Compacts the live list in the same pass: every id is written to both lists
+// and only the matching count advances, so there is no branch on the outcome.
+template<class HitTest>
+void BulletPool::update(const MazeGrid& grid, float deltaTime, HitTest hitTest) {
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < liveCount; ++i) {
+        std::uint32_t id = live[i];
+        Bullet& b = slots[id];
+        if(b.active) sweep(grid, b, deltaTime, hitTest);
+        live[kept] = id;
+        freeList[freeCount] = id;
+        kept += b.active;
+        freeCount += !b.active;
+    }
+    liveCount = kept;
+}
+
+#endif
@@ -1,23 +1,20 @@
 #ifndef CELL_H
 #define CELL_H
 
+#include "MazeGrid.h"
 #include <SFML/Graphics.hpp>
 
+// Read-only view of one MazeGrid cell, used for drawing.
 class Cell {
 private:
     int x, y;
-    bool visited;
-    bool walls[4]; // top, right, bottom, left
+    unsigned char bits;
 
 public:
-    Cell();
-    Cell(int x_, int y_);
+    Cell(int x_, int y_, unsigned char bits_);
 
-    void setVisited(bool v) { visited = v; }
-    bool isVisited() const { return visited; }
-
-    void removeWall(int direction) { walls[direction] = false; }
-    bool hasWall(int direction) const { return walls[direction]; }
+    bool isVisited() const { return (bits & MazeGrid::VISITED) != 0; }
+    bool hasWall(int direction) const { return (bits & (1 << direction)) != 0; }
 
     int getX() const { return x; }
     int getY() const { return y; }
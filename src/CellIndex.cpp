@@ -0,0 +1,46 @@
+#include "CellIndex.h"
+
+CellIndex::CellIndex(int cols_, int rows_) : cols(cols_), rows(rows_), heads(static_cast<size_t>(cols_) * rows_, NONE) {}
+
+void CellIndex::clear() {
+    for(int id = 0; id < static_cast<int>(cellOf.size()); ++id) {
+        if(cellOf[id] != NONE) heads[cellOf[id]] = NONE;
+    }
+    next.clear();
+    prev.clear();
+    cellOf.clear();
+}
+
+void CellIndex::unlink(int id) {
+    int cell = cellOf[id];
+    if(prev[id] != NONE) next[prev[id]] = next[id];
+    else heads[cell] = next[id];
+    if(next[id] != NONE) prev[next[id]] = prev[id];
+    next[id] = prev[id] = cellOf[id] = NONE;
+}
+
+void CellIndex::update(int id, int x, int y) {
+    if(id >= static_cast<int>(cellOf.size())) {
+        next.resize(id + 1, NONE);
+        prev.resize(id + 1, NONE);
+        cellOf.resize(id + 1, NONE);
+    }
+    int cell = (x < 0 || x >= cols || y < 0 || y >= rows) ? NONE : y * cols + x;
+    if(cell == cellOf[id]) return;
+    if(cellOf[id] != NONE) unlink(id);
+    if(cell == NONE) return;
+
+    next[id] = heads[cell];
+    if(heads[cell] != NONE) prev[heads[cell]] = id;
+    heads[cell] = id;
+    cellOf[id] = cell;
+}
+
+void CellIndex::remove(int id) {
+    if(contains(id)) unlink(id);
+}
+
+int CellIndex::first(int x, int y) const {
+    if(x < 0 || x >= cols || y < 0 || y >= rows) return NONE;
+    return heads[static_cast<size_t>(y) * cols + x];
+}
@@ -0,0 +1,41 @@
+#ifndef CELLINDEX_H
+#define CELLINDEX_H
+
+#include <vector>
+#include <cstddef>
+
+// Per-cell occupancy index: every cell heads an intrusive doubly linked list
+// of the entity ids standing on it, so "who is on this cell" is a bucket walk
+// and moving an entity is O(1). Ids are small dense integers (e.g. indices
+// into the owner's entity array). No SFML dependency.
+class CellIndex {
+public:
+    static constexpr int NONE = -1;
+
+private:
+    int cols, rows;
+    std::vector<int> heads;  // per cell: first id, or NONE
+    std::vector<int> next;   // per id: next id on the same cell
+    std::vector<int> prev;   // per id: previous id on the same cell
+    std::vector<int> cellOf; // per id: cell it is filed under, or NONE
+
+    void unlink(int id);
+
+public:
+    CellIndex(int cols_, int rows_);
+
+    // Drops every entry; capacity for ids is kept.
+    void clear();
+
+    // Files id under (x, y), or just removes it if the cell is off the grid.
+    // Re-filing on the same cell is a no-op, so callers can update every frame.
+    void update(int id, int x, int y);
+    void remove(int id);
+
+    // Iteration: for(int id = index.first(x, y); id != CellIndex::NONE; id = index.nextOf(id))
+    int first(int x, int y) const;
+    int nextOf(int id) const { return next[id]; }
+    bool contains(int id) const { return id >= 0 && id < static_cast<int>(cellOf.size()) && cellOf[id] != NONE; }
+};
+
+#endif
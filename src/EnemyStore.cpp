@@ -0,0 +1,185 @@
+#include "EnemyStore.h"
+#include <cmath>
+
+EnemyStore::EnemyStore(float speed_) : speed(speed_) {}
+
+std::size_t EnemyStore::add(float x, float y, float detectionRadius_, float health_) {
+    xs.push_back(x);
+    ys.push_back(y);
+    prevXs.push_back(x);
+    prevYs.push_back(y);
+    health.push_back(health_);
+    detectionRadius.push_back(detectionRadius_);
+    alive.push_back(1);
+    huntLeft.push_back(0);
+    routes.push_back(Route{-1, -1, -1});
+    return xs.size() - 1;
+}
+
+void EnemyStore::clear() {
+    xs.clear();
+    ys.clear();
+    prevXs.clear();
+    prevYs.clear();
+    moved.clear();
+    health.clear();
+    detectionRadius.clear();
+    alive.clear();
+    huntLeft.clear();
+    routes.clear();
+}
+
+void EnemyStore::removeAt(std::size_t i) {
+    std::size_t last = xs.size() - 1;
+    xs[i] = xs[last];
+    ys[i] = ys[last];
+    prevXs[i] = prevXs[last];
+    prevYs[i] = prevYs[last];
+    health[i] = health[last];
+    detectionRadius[i] = detectionRadius[last];
+    alive[i] = alive[last];
+    huntLeft[i] = huntLeft[last];
+    routes[i] = routes[last];
+    moved.push_back(i);
+    xs.pop_back();
+    ys.pop_back();
+    prevXs.pop_back();
+    prevYs.pop_back();
+    health.pop_back();
+    detectionRadius.pop_back();
+    alive.pop_back();
+    huntLeft.pop_back();
+    routes.pop_back();
+}
+
+int EnemyStore::getCellX(std::size_t i) const { return static_cast<int>(std::round(xs[i])); }
+int EnemyStore::getCellY(std::size_t i) const { return static_cast<int>(std::round(ys[i])); }
+
+void EnemyStore::beginTick() {
+    for(std::size_t i : moved) {
+        if(i >= xs.size()) continue;
+        prevXs[i] = xs[i];
+        prevYs[i] = ys[i];
+    }
+    moved.clear();
+}
+
+bool EnemyStore::takeDamage(std::size_t i, float amount) {
+    if(!alive[i]) return false;
+    health[i] -= amount;
+    if(health[i] <= 0) alive[i] = 0;
+    return !alive[i];
+}
+
+void EnemyStore::chase(std::size_t i, float targetX, float targetY, const FlowField& field, const MazeGrid& grid, float deltaTime) {
+    moved.push_back(i);
+    float step = speed * deltaTime;
+    float& x = xs[i];
+    float& y = ys[i];
+    int currCellX = getCellX(i);
+    int currCellY = getCellY(i);
+    int dir = field.getDirection(currCellX, currCellY);
+    bool atTarget = currCellX == field.getTargetX() && currCellY == field.getTargetY();
+    if(dir < 0 && !atTarget) {
+        greedyStep(i, targetX, targetY, grid, step);
+        return;
+    }
+
+    // Settle on the target cell's center.
+    if(atTarget) {
+        float offX = currCellX - x;
+        float offY = currCellY - y;
+        if(std::abs(offX) > step) x += (offX > 0 ? step : -step);
+        else if(std::abs(offY) > step) y += (offY > 0 ? step : -step);
+        else {
+            x = static_cast<float>(currCellX);
+            y = static_cast<float>(currCellY);
+        }
+        return;
+    }
+    stepAlong(i, dir, step);
+}
+
+bool EnemyStore::followRoute(std::size_t i, int targetX, int targetY, PathHierarchy& paths, const MazeGrid& grid, float deltaTime) {
+    moved.push_back(i);
+    float step = speed * deltaTime;
+    long long cell = static_cast<long long>(grid.index(getCellX(i), getCellY(i)));
+    Route& route = routes[i];
+    bool needRoute = false;
+    if(route.stepCell != cell) {
+        route.stepCell = cell;
+        route.stepDir = -1;
+        if(route.waypoint >= 0 && route.waypoint != cell) route.stepDir = paths.firstStep(grid, cell, route.waypoint);
+        if(route.stepDir < 0) {
+            route.waypoint = -1;
+            needRoute = true;
+        }
+    }
+    if(route.stepDir < 0) greedyStep(i, static_cast<float>(targetX), static_cast<float>(targetY), grid, step);
+    else stepAlong(i, route.stepDir, step);
+    return needRoute;
+}
+
+void EnemyStore::applyRoute(std::size_t i, size_t start, size_t waypoint, PathHierarchy& paths, const MazeGrid& grid) {
+    Route& route = routes[i];
+    if(route.stepCell != static_cast<long long>(start) || route.stepDir >= 0) return;
+    route.stepDir = paths.firstStep(grid, start, waypoint);
+    route.waypoint = route.stepDir < 0 ? -1 : static_cast<long long>(waypoint);
+}
+
+// Turns only from the cell center so the enemy never clips a wall corner.
+void EnemyStore::stepAlong(std::size_t i, int dir, float step) {
+    float& x = xs[i];
+    float& y = ys[i];
+    int currCellX = getCellX(i);
+    int currCellY = getCellY(i);
+    float offX = currCellX - x;
+    float offY = currCellY - y;
+    int stepX = MazeGrid::DX[dir];
+    int stepY = MazeGrid::DY[dir];
+    if(stepX != 0 && offY != 0) {
+        if(std::abs(offY) <= step) y = static_cast<float>(currCellY);
+        else y += (offY > 0 ? step : -step);
+        return;
+    }
+    if(stepY != 0 && offX != 0) {
+        if(std::abs(offX) <= step) x = static_cast<float>(currCellX);
+        else x += (offX > 0 ? step : -step);
+        return;
+    }
+    x += stepX * step;
+    y += stepY * step;
+}
+
+void EnemyStore::greedyStep(std::size_t i, float targetX, float targetY, const MazeGrid& grid, float step) {
+    float dx = targetX - xs[i];
+    float dy = targetY - ys[i];
+    int currCellX = getCellX(i);
+    int currCellY = getCellY(i);
+    const float threshold = 0.1f;
+
+    int stepX = 0;
+    int stepY = 0;
+    if(std::abs(dx) > std::abs(dy)) {
+        if(dx > threshold) stepX = 1;
+        else if(dx < -threshold) stepX = -1;
+    } else {
+        if(dy > threshold) stepY = 1;
+        else if(dy < -threshold) stepY = -1;
+    }
+    if(stepX == 0 && stepY == 0) return;
+
+    if(!grid.canMove(currCellX, currCellY, stepX, stepY)) {
+        // Blocked: try the other axis once.
+        if(stepX != 0) {
+            stepX = 0;
+            stepY = (dy > threshold) ? 1 : ((dy < -threshold) ? -1 : 0);
+        } else {
+            stepY = 0;
+            stepX = (dx > threshold) ? 1 : ((dx < -threshold) ? -1 : 0);
+        }
+        if((stepX == 0 && stepY == 0) || !grid.canMove(currCellX, currCellY, stepX, stepY)) return;
+    }
+    xs[i] += stepX * step;
+    ys[i] += stepY * step;
+}
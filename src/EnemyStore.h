@@ -0,0 +1,102 @@
+#ifndef ENEMYSTORE_H
+#define ENEMYSTORE_H
+
+#include "MazeGrid.h"
+#include "FlowField.h"
+#include "PathHierarchy.h"
+#include <vector>
+#include <cstddef>
+
+// All enemies of a level as parallel arrays (struct of arrays). Slots are
+// dense: a dead enemy is flagged, then removeAt() swaps the last enemy into
+// its slot, so per-frame loops walk contiguous floats with no pointer chasing
+// or virtual calls. No SFML dependency.
+class EnemyStore {
+private:
+    std::vector<float> xs, ys;
+    std::vector<float> prevXs, prevYs; // positions at the start of the tick
+    // Slots whose position may differ from prevXs/prevYs: the enemies moved
+    // this tick and slots refilled by removeAt(). Every other enemy already
+    // has prev == current, so beginTick() only resets these.
+    std::vector<std::size_t> moved;
+    std::vector<float> health;
+    std::vector<float> detectionRadius;
+    std::vector<unsigned char> alive;
+    std::vector<float> huntLeft; // seconds an enemy keeps pursuing after losing sight
+    // Long-range pursuit state: the next waypoint of the planned route and
+    // the step direction, cached for the cell it was worked out in.
+    struct Route {
+        long long waypoint; // cell index, or -1 to replan
+        long long stepCell;
+        int stepDir;
+    };
+    std::vector<Route> routes;
+    float speed; // cells per second
+
+public:
+    explicit EnemyStore(float speed_ = 3.0f);
+
+    std::size_t size() const { return xs.size(); }
+    std::size_t add(float x, float y, float detectionRadius_, float health_ = 3.0f);
+    void clear();
+    // Moves the last enemy into slot i and drops the last slot.
+    void removeAt(std::size_t i);
+
+    // Coordinate arrays, size() long, for batch kernels.
+    const float* getXs() const { return xs.data(); }
+    const float* getYs() const { return ys.data(); }
+    const float* getPrevXs() const { return prevXs.data(); }
+    const float* getPrevYs() const { return prevYs.data(); }
+    float getX(std::size_t i) const { return xs[i]; }
+    float getY(std::size_t i) const { return ys[i]; }
+    // Cell an enemy occupies for movement and collisions (nearest center).
+    int getCellX(std::size_t i) const;
+    int getCellY(std::size_t i) const;
+    // Position blended between the last two ticks; alpha in [0, 1].
+    float getRenderX(std::size_t i, float alpha) const { return prevXs[i] + (xs[i] - prevXs[i]) * alpha; }
+    float getRenderY(std::size_t i, float alpha) const { return prevYs[i] + (ys[i] - prevYs[i]) * alpha; }
+    float getHealth(std::size_t i) const { return health[i]; }
+    float getDetectionRadius(std::size_t i) const { return detectionRadius[i]; }
+    bool isAlive(std::size_t i) const { return alive[i] != 0; }
+    bool isHunting(std::size_t i) const { return huntLeft[i] > 0; }
+
+    // Snapshots positions for interpolation; call once at the start of a
+    // tick. Costs the enemies that moved last tick, not the enemy count.
+    void beginTick();
+
+    // Returns true if this hit killed the enemy.
+    bool takeDamage(std::size_t i, float amount);
+    // Keeps enemy i pursuing for at least seconds more; the caller counts
+    // the time down with endHuntTick(). A new hunt drops any old route.
+    void hunt(std::size_t i, float seconds) {
+        if(huntLeft[i] <= 0) routes[i] = Route{-1, -1, -1};
+        if(huntLeft[i] < seconds) huntLeft[i] = seconds;
+    }
+    void endHuntTick(std::size_t i, float deltaTime) { huntLeft[i] -= deltaTime; }
+
+    // (px, py) lies within enemy i's detection circle.
+    bool inDetectionRange(std::size_t i, float px, float py) const {
+        float dx = xs[i] - px;
+        float dy = ys[i] - py;
+        return dx * dx + dy * dy <= detectionRadius[i] * detectionRadius[i];
+    }
+
+    // Moves deltaTime seconds along the flow field toward (targetX, targetY);
+    // uses a greedy step where the field has no direction.
+    void chase(std::size_t i, float targetX, float targetY, const FlowField& field, const MazeGrid& grid, float deltaTime);
+    // Moves deltaTime seconds toward the next waypoint of the enemy's route
+    // to cell (targetX, targetY), for pursuers beyond the flow field.
+    // Returns true when the enemy has no route from its cell (on reaching a
+    // waypoint or after a new hunt); it then steps greedily until the
+    // caller plans one and hands it to applyRoute().
+    bool followRoute(std::size_t i, int targetX, int targetY, PathHierarchy& paths, const MazeGrid& grid, float deltaTime);
+    // Sets the first waypoint of a route planned from cell start. Ignored
+    // if the enemy has moved on from start since asking for it.
+    void applyRoute(std::size_t i, size_t start, size_t waypoint, PathHierarchy& paths, const MazeGrid& grid);
+
+private:
+    void greedyStep(std::size_t i, float targetX, float targetY, const MazeGrid& grid, float step);
+    void stepAlong(std::size_t i, int dir, float step);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "FlowField.h"
+
+FlowField::FlowField(int cols_, int rows_) : cols(cols_), rows(rows_), targetX(-1), targetY(-1), directions(static_cast<size_t>(cols_) * rows_, NONE) {}
+
+void FlowField::compute(const MazeGrid& grid, int targetX_, int targetY_, int maxDistance) {
+    for(size_t cell : reached) directions[cell] = NONE;
+    reached.clear();
+    targetX = targetX_;
+    targetY = targetY_;
+    if(!grid.inBounds(targetX, targetY)) return;
+
+    // The target is marked with a dummy direction so it counts as reached.
+    size_t target = grid.index(targetX, targetY);
+    directions[target] = 0;
+    reached.push_back(target);
+
+    size_t head = 0;
+    for(int distance = 0; head < reached.size() && (maxDistance < 0 || distance < maxDistance); ++distance) {
+        size_t levelEnd = reached.size();
+        for(; head < levelEnd; ++head) {
+            size_t cell = reached[head];
+            for(int dir = 0; dir < 4; ++dir) {
+                if(grid.hasWall(cell, dir)) continue;
+                size_t next = grid.neighbor(cell, dir);
+                if(directions[next] != NONE) continue;
+                // Stepping back from 'next' toward 'cell' is the opposite direction.
+                directions[next] = static_cast<unsigned char>((dir + 2) % 4);
+                reached.push_back(next);
+            }
+        }
+    }
+    directions[target] = NONE;
+}
+
+int FlowField::getDirection(int x, int y) const {
+    if(x < 0 || x >= cols || y < 0 || y >= rows) return -1;
+    unsigned char dir = directions[static_cast<size_t>(y) * cols + x];
+    return dir == NONE ? -1 : dir;
+}
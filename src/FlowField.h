@@ -0,0 +1,38 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "MazeGrid.h"
+#include <vector>
+#include <cstddef>
+
+// Breadth-first flow field toward one target cell. After compute(), every
+// reached cell stores the direction of its next step along a shortest path,
+// so any number of chasers read their move in O(1). Recompute only when the
+// target changes cell. No SFML dependency.
+class FlowField {
+public:
+    static constexpr unsigned char NONE = 4;
+
+private:
+    int cols, rows;
+    int targetX, targetY;
+    std::vector<unsigned char> directions;
+    // Cells reached by the last compute(), in BFS order; reset lazily so a
+    // bounded search costs what it visits, not the grid size.
+    std::vector<size_t> reached;
+
+public:
+    FlowField(int cols_, int rows_);
+
+    // maxDistance < 0 searches the whole maze.
+    void compute(const MazeGrid& grid, int targetX_, int targetY_, int maxDistance = -1);
+
+    // Direction (0=top, 1=right, 2=bottom, 3=left) to step from (x, y), or -1
+    // at the target or where the last search did not reach.
+    int getDirection(int x, int y) const;
+    int getTargetX() const { return targetX; }
+    int getTargetY() const { return targetY; }
+    size_t getReachedCount() const { return reached.size(); }
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "FogOfWar.h"
+#include "MazeRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const sf::Color UNEXPLORED(0, 0, 0, 255);
+    const sf::Color EXPLORED(0, 0, 0, 200);
+
+    // Keeps the destination colour and scales its alpha by (1 - source
+    // alpha), so drawing light erases fog.
+    const sf::BlendMode ERASE_FOG(sf::BlendMode::Zero, sf::BlendMode::One, sf::BlendMode::Add,
+                                  sf::BlendMode::Zero, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+}
+
+FogOfWar::FogOfWar(int cols_, int rows_, int cellSize_, unsigned viewWidth, unsigned viewHeight)
+    : cols(cols_), rows(rows_), cellSize(cellSize_), ready(false), renderer(nullptr), frameNumber(0),
+      explored(static_cast<size_t>(cols_) * rows_, 0), newlyExplored(sf::Quads), revealedX(-1), revealedY(-1), revealedRadius(0),
+      light(sf::Quads) {
+    ready = fogLayer.create(viewWidth, viewHeight);
+}
+
+FogOfWar::~FogOfWar() {
+    for(Chunk* chunk : chunks) delete chunk;
+}
+
+void FogOfWar::reset(MazeRenderer& renderer_) {
+    renderer = &renderer_;
+    for(Chunk* chunk : chunks) chunk->x = chunk->y = -1;
+    std::fill(explored.begin(), explored.end(), 0);
+    revealedX = revealedY = -1;
+    revealedRadius = 0;
+}
+
+void FogOfWar::appendCellQuad(sf::VertexArray& quads, size_t cell, const sf::Color& color) const {
+    float left = static_cast<float>((cell % cols) * cellSize);
+    float top = static_cast<float>((cell / cols) * cellSize);
+    quads.append(sf::Vertex(sf::Vector2f(left, top), color));
+    quads.append(sf::Vertex(sf::Vector2f(left + cellSize, top), color));
+    quads.append(sf::Vertex(sf::Vector2f(left + cellSize, top + cellSize), color));
+    quads.append(sf::Vertex(sf::Vector2f(left, top + cellSize), color));
+}
+
+FogOfWar::Chunk* FogOfWar::findChunk(int chunkX, int chunkY) const {
+    for(Chunk* chunk : chunks) {
+        if(chunk->x == chunkX && chunk->y == chunkY) return chunk;
+    }
+    return nullptr;
+}
+
+// Resident chunk at (chunkX, chunkY), baking it into a new or the least
+// recently drawn texture pair if needed. Null if no texture is available.
+FogOfWar::Chunk* FogOfWar::acquireChunk(int chunkX, int chunkY) {
+    Chunk* chunk = findChunk(chunkX, chunkY);
+    if(!chunk) {
+        if(static_cast<int>(chunks.size()) < MAX_CHUNKS) {
+            // Two extra pixels hold the maze's right and bottom border walls.
+            unsigned pixels = static_cast<unsigned>(CHUNK_CELLS * cellSize);
+            chunk = new Chunk();
+            if(!chunk->maze.create(pixels + 2, pixels + 2) || !chunk->explored.create(pixels, pixels)) {
+                delete chunk;
+                return nullptr;
+            }
+            chunks.push_back(chunk);
+        } else {
+            for(Chunk* candidate : chunks) {
+                if(candidate->lastUsed != frameNumber && (!chunk || candidate->lastUsed < chunk->lastUsed)) chunk = candidate;
+            }
+            if(!chunk) return nullptr;
+        }
+        chunk->x = chunkX;
+        chunk->y = chunkY;
+        bakeChunk(*chunk);
+    }
+    chunk->lastUsed = frameNumber;
+    return chunk;
+}
+
+void FogOfWar::bakeChunk(Chunk& chunk) {
+    float pixels = static_cast<float>(CHUNK_CELLS * cellSize);
+    float left = chunk.x * pixels;
+    float top = chunk.y * pixels;
+    int minX = chunk.x * CHUNK_CELLS;
+    int minY = chunk.y * CHUNK_CELLS;
+
+    chunk.maze.setView(sf::View(sf::FloatRect(left, top, pixels + 2, pixels + 2)));
+    chunk.maze.clear(sf::Color::Transparent);
+    renderer->drawRange(chunk.maze, minX, minY, minX + CHUNK_CELLS - 1, minY + CHUNK_CELLS - 1);
+    chunk.maze.display();
+
+    newlyExplored.clear();
+    for(int y = minY; y < std::min(rows, minY + CHUNK_CELLS); ++y) {
+        for(int x = minX; x < std::min(cols, minX + CHUNK_CELLS); ++x) {
+            size_t cell = static_cast<size_t>(y) * cols + x;
+            if(explored[cell]) appendCellQuad(newlyExplored, cell, EXPLORED);
+        }
+    }
+    chunk.explored.setView(sf::View(sf::FloatRect(left, top, pixels, pixels)));
+    chunk.explored.clear(UNEXPLORED);
+    if(newlyExplored.getVertexCount() > 0) chunk.explored.draw(newlyExplored, sf::RenderStates(sf::BlendNone));
+    chunk.explored.display();
+}
+
+void FogOfWar::reveal(const std::vector<size_t>& cells, int cellX, int cellY, float radius) {
+    if(!ready || (cellX == revealedX && cellY == revealedY && radius == revealedRadius)) return;
+    revealedX = cellX;
+    revealedY = cellY;
+    revealedRadius = radius;
+
+    newlyExplored.clear();
+    for(size_t cell : cells) {
+        if(explored[cell]) continue;
+        explored[cell] = 1;
+        appendCellQuad(newlyExplored, cell, EXPLORED);
+    }
+    if(newlyExplored.getVertexCount() == 0) return;
+    // Chunks that are not resident pick the cells up when they are baked.
+    for(Chunk* chunk : chunks) {
+        if(chunk->x < 0) continue;
+        chunk->explored.draw(newlyExplored, sf::RenderStates(sf::BlendNone));
+        chunk->explored.display();
+    }
+}
+
+// Light at a cell corner: full inside LIGHT_SOFT_EDGE of the radius, fading
+// to none at the radius. Neighbouring quads share corners, so the fade is
+// continuous across cells.
+void FogOfWar::draw(sf::RenderTarget& target, const sf::View& camera, const std::vector<size_t>& cells, float centerX, float centerY, float radius) {
+    if(!ready || !renderer) return;
+    ++frameNumber;
+
+    sf::Vector2f size = camera.getSize();
+    float left = camera.getCenter().x - size.x / 2;
+    float top = camera.getCenter().y - size.y / 2;
+    float chunkPixels = static_cast<float>(CHUNK_CELLS * cellSize);
+    int minChunkX = std::max(0, static_cast<int>(std::floor(left / chunkPixels)));
+    int minChunkY = std::max(0, static_cast<int>(std::floor(top / chunkPixels)));
+    int maxChunkX = std::min((cols - 1) / CHUNK_CELLS, static_cast<int>(std::floor((left + size.x) / chunkPixels)));
+    int maxChunkY = std::min((rows - 1) / CHUNK_CELLS, static_cast<int>(std::floor((top + size.y) / chunkPixels)));
+
+    fogLayer.setView(sf::View(camera.getCenter(), size));
+    fogLayer.clear(UNEXPLORED);
+    for(int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+        for(int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+            Chunk* chunk = acquireChunk(chunkX, chunkY);
+            if(!chunk) {
+                ready = false;
+                return;
+            }
+            sf::Sprite mask(chunk->explored.getTexture());
+            mask.setPosition(chunkX * chunkPixels, chunkY * chunkPixels);
+            fogLayer.draw(mask, sf::RenderStates(sf::BlendNone));
+        }
+    }
+
+    float cx = centerX + 0.5f;
+    float cy = centerY + 0.5f;
+    float fade = std::max(radius * (1 - LIGHT_SOFT_EDGE), 0.001f);
+    auto corner = [&](int x, int y) {
+        float dx = x - cx;
+        float dy = y - cy;
+        float amount = (radius - std::sqrt(dx * dx + dy * dy)) / fade;
+        amount = std::min(1.0f, std::max(0.0f, amount));
+        return sf::Vertex(sf::Vector2f(static_cast<float>(x * cellSize), static_cast<float>(y * cellSize)), sf::Color(255, 255, 255, static_cast<sf::Uint8>(amount * 255)));
+    };
+    light.clear();
+    for(size_t cell : cells) {
+        int x = static_cast<int>(cell % cols);
+        int y = static_cast<int>(cell / cols);
+        light.append(corner(x, y));
+        light.append(corner(x + 1, y));
+        light.append(corner(x + 1, y + 1));
+        light.append(corner(x, y + 1));
+    }
+    fogLayer.draw(light, sf::RenderStates(ERASE_FOG));
+    fogLayer.display();
+
+    for(int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+        for(int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+            sf::Sprite maze(findChunk(chunkX, chunkY)->maze.getTexture());
+            maze.setPosition(chunkX * chunkPixels, chunkY * chunkPixels);
+            target.draw(maze);
+        }
+    }
+    sf::Sprite fog(fogLayer.getTexture());
+    fog.setPosition(left, top);
+    target.draw(fog);
+}
@@ -0,0 +1,74 @@
+#ifndef FOGOFWAR_H
+#define FOGOFWAR_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class MazeRenderer;
+
+// Fog of war for the play view. The finished maze is baked into render
+// textures of CHUNK_CELLS x CHUNK_CELLS cells, created lazily for the chunks
+// under the camera and recycled least-recently-used, so texture memory and
+// frame cost follow the view rather than the maze size. Darkness is a
+// view-sized layer: per-chunk explored masks (opaque where never seen,
+// dimmed where seen before) with the cells in line of sight cut out by light
+// quads that fade toward the vision radius. Cells are added to the explored
+// mask only when the player's cell or vision radius changes. Render thread
+// only.
+class FogOfWar {
+private:
+    static const int CHUNK_CELLS = 32;
+    static const int MAX_CHUNKS = 12;
+    static constexpr float LIGHT_SOFT_EDGE = 0.8f; // fraction of the radius at full light
+
+    struct Chunk {
+        int x, y; // chunk coordinates; -1 while unused
+        sf::RenderTexture maze;
+        sf::RenderTexture explored;
+        unsigned long long lastUsed;
+    };
+
+    int cols, rows, cellSize;
+    bool ready;
+    MazeRenderer* renderer;
+    std::vector<Chunk*> chunks;
+    unsigned long long frameNumber;
+
+    sf::RenderTexture fogLayer;
+
+    std::vector<unsigned char> explored;
+    sf::VertexArray newlyExplored;
+    int revealedX, revealedY;
+    float revealedRadius;
+
+    // One quad per visible cell; vertex alpha is the amount of light.
+    sf::VertexArray light;
+
+    Chunk* findChunk(int chunkX, int chunkY) const;
+    Chunk* acquireChunk(int chunkX, int chunkY);
+    void bakeChunk(Chunk& chunk);
+    void appendCellQuad(sf::VertexArray& quads, size_t cell, const sf::Color& color) const;
+
+public:
+    // viewWidth x viewHeight is the camera size in pixels.
+    FogOfWar(int cols_, int rows_, int cellSize_, unsigned viewWidth, unsigned viewHeight);
+    ~FogOfWar();
+
+    // False when render textures are unavailable; callers fall back to
+    // drawing the maze directly.
+    bool isReady() const { return ready; }
+
+    // Starts a new level drawn from renderer (which must stay alive) and
+    // forgets everything explored.
+    void reset(MazeRenderer& renderer_);
+    // cells are the visible cells (index y * cols + x) seen from (cellX,
+    // cellY) with the given radius; they are re-read only when those change.
+    void reveal(const std::vector<size_t>& cells, int cellX, int cellY, float radius);
+    bool isExplored(int x, int y) const { return explored[static_cast<size_t>(y) * cols + x] != 0; }
+
+    // Maze plus fog under camera, with the visible cells lit around cell
+    // (centerX, centerY). target must currently use camera as its view.
+    void draw(sf::RenderTarget& target, const sf::View& camera, const std::vector<size_t>& cells, float centerX, float centerY, float radius);
+};
+
+#endif
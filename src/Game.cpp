@@ -1,16 +1,24 @@
 #include "Game.h"
+#include "RangeKernels.h"
+#include "Profiler.h"
 #include <sstream>
 #include <fstream>
 #include <algorithm>
-#include <ctime>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
-#include <random>
+#include <thread>
 #include <unordered_map>
 
 
-Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "The Enlightened Path"), currentState(WELCOME), maze(nullptr), player(nullptr), currentRiddleIndex(-1), elapsedTime(0), playerDeadThisFrame(false), previousState(WELCOME) {
-    window.setFramerateLimit(60);
+Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "The Enlightened Path"), currentState(WELCOME), maze(nullptr), sim(nullptr), player(nullptr), leaderboardVersion(0), currentRiddleIndex(-1), accumulator(0), timeScale(1.0f), elapsedTime(0), levelId(0), mazeChangesFrom(0), levelVersion(0), running(false), mazeView(nullptr), mazeViewLevel(0), mazeViewVersion(0), fog(nullptr), fogLevel(0), renderAlpha(1.0f), hud(MAZE_WIDTH, MAZE_HEIGHT), playerDeadThisFrame(false), previousState(WELCOME),
+    seedSource(static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())), levelSeed(0), fixedSeed(false) {
+    window.setFramerateLimit(RENDER_FPS);
+    camera.setSize(MAZE_WIDTH, MAZE_HEIGHT);
+    camera.setCenter(MAZE_WIDTH / 2, MAZE_HEIGHT / 2);
+    camera.setViewport(sf::FloatRect(0, 0, static_cast<float>(MAZE_WIDTH) / WINDOW_WIDTH, static_cast<float>(MAZE_HEIGHT) / WINDOW_HEIGHT));
 
     if(welcomeTexture.loadFromFile("Images/welcome.jpg")) {
         welcomeSprite.setTexture(welcomeTexture);
@@ -58,16 +66,34 @@ Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "The Enlighten
     if(!fontLoaded) {
         std::cout << "Warning: Could not load any of the candidate fonts.\n";
     }
+    hud.setFont(gameFont);
+#ifdef PROFILER_ENABLED
+    profilerVisible = false;
+    profilerRefresh = 0;
+    profilerText.setFont(gameFont);
+    profilerText.setCharacterSize(13);
+    profilerText.setFillColor(sf::Color(180, 255, 180));
+    profilerText.setPosition(MAZE_WIDTH + 25, 340);
+#endif
 
     loadScores();
-    srand((unsigned)time(0));
+}
+
+void Game::setSeed(std::uint64_t seed) {
+    levelSeed = seed;
+    fixedSeed = true;
+}
+
+void Game::setTimeScale(float scale) {
+    if(scale > 0) timeScale = scale;
 }
 
 Game::~Game() {
+    delete sim;
     delete maze;
-    delete player;
+    delete mazeView;
+    delete fog;
     for(auto r : riddles) delete r;
-    for(auto e : enemies) delete e;
 }
 
 void Game::createRiddles() {
@@ -134,13 +160,11 @@ void Game::createRiddles() {
     }
     if(rf.is_open()) rf.close();
 
-    std::random_device rd;
-    std::mt19937 rng(rd());
     std::shuffle(allRiddles.begin(), allRiddles.end(), rng);
     int choose = std::min(10, (int)allRiddles.size());
     for(int i = 0; i < choose; ++i) {
-        int posX = rand() % (COLS - 4) + 2;
-        int posY = rand() % (ROWS - 4) + 2;
+        int posX = rng.range(2, COLS - 3);
+        int posY = rng.range(2, ROWS - 3);
         Riddle* newRiddle = nullptr;
         if(allRiddles[i].difficulty == 0)
             newRiddle = new EasyRiddle(allRiddles[i].question, allRiddles[i].answer, posX, posY, CELL_SIZE, allRiddles[i].rewardType);
@@ -148,88 +172,11 @@ void Game::createRiddles() {
             newRiddle = new HardRiddle(allRiddles[i].question, allRiddles[i].answer, posX, posY, CELL_SIZE, allRiddles[i].rewardType);
         else
             newRiddle = new Riddle(allRiddles[i].question, allRiddles[i].answer, posX, posY, CELL_SIZE, allRiddles[i].rewardType);
+        sim->addRiddle(posX, posY);
         riddles.push_back(newRiddle);
     }
 }
 
-void Game::spawnEnemies() {
-    for(auto e : enemies) delete e;
-    enemies.clear();
-    
-    int numEnemies = 3 + rand() % 3;
-    const float enemyDetection = 5.0f;
-    const int minDistance = static_cast<int>(enemyDetection) + 2; 
-    int startX = player->getCellX();
-    int startY = player->getCellY();
-    for(int i = 0; i < numEnemies; ++i) {
-        int ex, ey;
-        int attempts = 0;
-        do {
-            ex = rand() % COLS;
-            ey = rand() % ROWS;
-            ++attempts;
-        } while(((abs(ex - startX) < minDistance) && (abs(ey - startY) < minDistance)) || (ex == maze->getFinishX() && ey == maze->getFinishY()) && attempts < 200);
-        
-        if((abs(ex - startX) < minDistance) && (abs(ey - startY) < minDistance)) {
-            ex = std::min(COLS-1, startX + minDistance);
-            ey = std::min(ROWS-1, startY + minDistance);
-        }
-        
-        Enemy* newEnemy = new Enemy(ex, ey, CELL_SIZE, enemyDetection);
-        enemies.push_back(newEnemy);
-    }
-}
-
-void Game::updateEnemies() {
-    for(auto e : enemies) {
-        if(!e->dead()) {
-            if(e->isInDetectionRange(*player) && !player->getIsInvisible()) {
-                e->moveTowardPlayer(*player, COLS, ROWS, maze);
-            }
-        }
-    }
-}
-
-void Game::checkEnemyCollisions() {
-    for(auto e : enemies) {
-        if(!e->dead()) {
-            int px = player->getCellX();
-            int py = player->getCellY();
-            int ex = static_cast<int>(e->getX());
-            int ey = static_cast<int>(e->getY());
-            
-            if(px == ex && py == ey){
-                if(!player->getIsInvisible()) {
-                    player->takeDamage(1.0f);
-                }
-            }
-        }
-    }
-}
-
-void Game::checkBulletCollisions() {
-    auto& bullets = player->getBullets();
-    for(size_t i = 0; i < bullets.size(); ++i) {
-        if(!bullets[i].active) continue;
-        
-        int bx = static_cast<int>(bullets[i].x);
-        int by = static_cast<int>(bullets[i].y);
-        
-        for(auto e : enemies) {
-            if(!e->dead()) {
-                int ex = static_cast<int>(e->getX());
-                int ey = static_cast<int>(e->getY());
-                
-                if(bx == ex && by == ey) {
-                    e->takeDamage(10.0f);
-                    bullets[i].active = false;
-                    break;
-                }
-            }
-        }
-    }
-}
-
 void Game::loadScores() {
     leaderboard.clear();
     std::ifstream file("leaderboard.txt");
@@ -245,6 +192,7 @@ void Game::loadScores() {
         for(const auto &p : bestTimes) leaderboard.push_back(LeaderboardEntry(p.first, p.second));
     }
     std::sort(leaderboard.begin(), leaderboard.end());
+    ++leaderboardVersion;
 }
 
 void Game::saveScores() {
@@ -271,23 +219,20 @@ void Game::addScore(const std::string& name, float time) {
     }
     std::sort(leaderboard.begin(), leaderboard.end());
     if(leaderboard.size() > 10) leaderboard.resize(10);
+    ++leaderboardVersion;
     saveScores();
 }
 
 void Game::checkForRiddle() {
-    for(size_t i = 0; i < riddles.size(); ++i) {
-        bool riddleNotSolved = !riddles[i]->isSolved();
-        bool playerOnRiddle = (player->getCellX() == (int)riddles[i]->getX() && player->getCellY() == (int)riddles[i]->getY());
-        if(riddleNotSolved && playerOnRiddle) { 
-            currentState = RIDDLE_ACTIVE; 
-            currentRiddleIndex = (int)i; 
-            playerAnswer.clear(); 
-            return; 
-        }
+    int id = sim->riddleAtPlayer();
+    if(id >= 0) {
+        currentState = RIDDLE_ACTIVE;
+        currentRiddleIndex = id;
+        playerAnswer.clear();
     }
 }
 
-void Game::showWelcomeScreen() {
+void Game::showWelcomeScreen(const FrameSnapshot& frame) {
     window.draw(welcomeSprite);
 
     sf::RectangleShape overlay(sf::Vector2f(600, 400));
@@ -313,7 +258,7 @@ void Game::showWelcomeScreen() {
     nameBox.setOutlineThickness(2);
     window.draw(nameBox);
 
-    sf::Text nameDisplay(playerName + "_", gameFont, 25);
+    sf::Text nameDisplay(frame.playerName + "_", gameFont, 25);
     nameDisplay.setPosition(WINDOW_WIDTH / 2 - 140, 325);
     nameDisplay.setFillColor(sf::Color::Yellow);
     window.draw(nameDisplay);
@@ -324,7 +269,8 @@ void Game::showWelcomeScreen() {
     window.draw(instructions);
 }
 
-void Game::showLeaderboard() {
+void Game::showLeaderboard(const FrameSnapshot& frame) {
+    const std::vector<LeaderboardEntry>& leaderboard = frame.leaderboard;
     window.clear(sf::Color(20, 20, 40));
     sf::Text title("LEADERBOARD", gameFont, 40);
     title.setPosition(WINDOW_WIDTH / 2 - 150, 50); 
@@ -348,161 +294,14 @@ void Game::showLeaderboard() {
     window.draw(back);
 }
 
-void Game::showMiniLeaderboard() {
-    sf::RectangleShape box(sf::Vector2f(220, 300)); 
-    box.setPosition(MAZE_WIDTH + 20, 20); 
-    box.setFillColor(sf::Color(30, 30, 50, 200)); 
-    box.setOutlineColor(sf::Color(100, 100, 120)); 
-    box.setOutlineThickness(2); 
-    window.draw(box);
-    
-    sf::Text title("Current Leaderboard", gameFont, 18); 
-    title.setPosition(MAZE_WIDTH + 40, 30); 
-    title.setFillColor(sf::Color(255, 220, 100)); 
-    window.draw(title);
-    
-    int yPos = 70;
-    for(size_t i = 0; i < leaderboard.size() && i < 5; i++) {
-        std::stringstream text; 
-        text << (i + 1) << ". " << leaderboard[i].name.substr(0, 8) << " " << (int)leaderboard[i].time << "s";
-        sf::Text entry(text.str(), gameFont, 14); 
-        entry.setPosition(MAZE_WIDTH + 35, yPos); 
-        entry.setFillColor(sf::Color(200, 200, 200)); 
-        window.draw(entry); 
-        yPos += 35;
-    }
-}
-
-void Game::showRiddleBox() {
-    sf::RectangleShape box(sf::Vector2f(MAZE_WIDTH - 40, 150)); 
-    box.setPosition(20, MAZE_HEIGHT + 20); 
-    box.setFillColor(sf::Color(40, 40, 70, 230)); 
-    box.setOutlineColor(sf::Color(255, 220, 100)); 
-    box.setOutlineThickness(3); 
-    window.draw(box);
-    
-    if(currentRiddleIndex >= 0 && currentRiddleIndex < (int)riddles.size()) {
-        Riddle* activeRiddle = riddles[currentRiddleIndex];
-        
-        sf::Text question(activeRiddle->getQuestion(), gameFont, 16); 
-        question.setPosition(40, MAZE_HEIGHT + 35); 
-        question.setFillColor(sf::Color(255, 255, 255)); 
-        window.draw(question);
-        
-        std::stringstream rewardText;
-        RiddleRewardType rt = activeRiddle->getRewardType();
-
-        if (rt == VISION_REWARD) {
-            rewardText << "Reward: +" << activeRiddle->getReward()
-                       << " vision";
-
-        } else if (rt == INVISIBILITY_REWARD) {
-            rewardText << "Reward: Invisibility";
-
-        } else if (rt == KILL_POWER_REWARD) {
-            rewardText << "Reward: Kill Power + 6 Ammo";
-
-        } else if (rt == HEALTH_REWARD) {
-            rewardText << "Reward: +" << activeRiddle->getReward()<< " health";
-        }
-        sf::Text reward(rewardText.str(), gameFont, 14); 
-        reward.setPosition(40, MAZE_HEIGHT + 60); 
-        reward.setFillColor(sf::Color(150, 255, 150)); 
-        window.draw(reward);
-        
-        sf::RectangleShape inputBox(sf::Vector2f(MAZE_WIDTH - 80, 40)); 
-        inputBox.setPosition(40, MAZE_HEIGHT + 90); 
-        inputBox.setFillColor(sf::Color(20, 20, 40)); 
-        inputBox.setOutlineColor(sf::Color(100, 100, 150)); 
-        inputBox.setOutlineThickness(2); 
-        window.draw(inputBox);
-        
-        sf::Text input("Answer: " + playerAnswer + "_", gameFont, 18); 
-        input.setPosition(50, MAZE_HEIGHT + 100); 
-        input.setFillColor(sf::Color(200, 200, 200)); 
-        window.draw(input);
-        
-        sf::Text hint("Press ENTER to submit | ESC to close", gameFont, 12); 
-        hint.setPosition(40, MAZE_HEIGHT + 145); 
-        hint.setFillColor(sf::Color(150, 150, 150)); 
-        window.draw(hint);
+void Game::showRiddleMarkers(const FrameSnapshot& frame) {
+    TileRange tiles = visibleTiles();
+    for(const RiddleView& r : frame.riddles) {
+        if(!r.solved && r.visible && tiles.overlaps(r.x, r.y)) Riddle::drawMarker(window, r.x, r.y, CELL_SIZE, r.color);
     }
 }
 
-void Game::showGameInfo() {
-    std::stringstream timeText; 
-    timeText << "Time: " << (int)elapsedTime << "s"; 
-    sf::Text timeDisplay(timeText.str(), gameFont, 20); 
-    timeDisplay.setPosition(20, MAZE_HEIGHT + 180); 
-    timeDisplay.setFillColor(sf::Color(255, 220, 100)); 
-    window.draw(timeDisplay);
-    
-    int solvedCount = 0; 
-    for(const auto& r : riddles) if(r->isSolved()) ++solvedCount;
-    
-    std::stringstream riddleText; 
-    riddleText << "Riddles: " << solvedCount << "/" << riddles.size(); 
-    sf::Text riddleDisplay(riddleText.str(), gameFont, 20); 
-    riddleDisplay.setPosition(180, MAZE_HEIGHT + 180); 
-    riddleDisplay.setFillColor(sf::Color(200, 200, 255)); 
-    window.draw(riddleDisplay);
-    
-    std::stringstream visionText; 
-    visionText << "Vision: " << (int)player->getVisionRadius(); 
-    sf::Text visionDisplay(visionText.str(), gameFont, 20); 
-    visionDisplay.setPosition(380, MAZE_HEIGHT + 180); 
-    visionDisplay.setFillColor(sf::Color(150, 255, 150)); 
-    window.draw(visionDisplay);
-    
-    std::stringstream ammoText; 
-    ammoText << "Ammo: " << player->getAmmo(); 
-    sf::Text ammoDisplay(ammoText.str(), gameFont, 20); 
-    ammoDisplay.setPosition(550, MAZE_HEIGHT + 180); 
-    ammoDisplay.setFillColor(sf::Color(255, 200, 100)); 
-    window.draw(ammoDisplay);
-}
-
-void Game::showHealthBar() {
-    int barX = 20;
-    int barY = MAZE_HEIGHT + 20;
-    
-    sf::RectangleShape healthBarBg(sf::Vector2f(250, 30));
-    healthBarBg.setPosition(barX, barY);
-    healthBarBg.setFillColor(sf::Color(50, 50, 50));
-    healthBarBg.setOutlineColor(sf::Color(100, 100, 100));
-    healthBarBg.setOutlineThickness(2);
-    window.draw(healthBarBg);
-    
-    float healthPercent = player->getHealth() / player->getMaxHealth();
-    sf::RectangleShape healthBarFill(sf::Vector2f(250 * healthPercent, 30));
-    healthBarFill.setPosition(barX, barY);
-    
-    if(player->getHealth() > 2.0f) {
-        healthBarFill.setFillColor(sf::Color(0, 255, 0)); 
-    } else if(player->getHealth() > 1.0f) {
-        healthBarFill.setFillColor(sf::Color(255, 255, 0)); 
-    } else {
-        healthBarFill.setFillColor(sf::Color(255, 0, 0)); 
-    }
-    
-    window.draw(healthBarFill);
-    
-    std::stringstream healthText;
-    healthText << "HP: " << (int)player->getHealth() << "/" << (int)player->getMaxHealth();
-    sf::Text healthLabel(healthText.str(), gameFont, 14);
-    healthLabel.setPosition(barX + 10, barY + 6);
-    healthLabel.setFillColor(sf::Color(255, 255, 255));
-    window.draw(healthLabel);
-}
-
-void Game::showRiddleMarkers() {
-    for(const auto& r : riddles) {
-        bool canSeeRiddle = player->isInVision(r->getX(), r->getY());
-        if(!r->isSolved() && canSeeRiddle) r->draw(window);
-    }
-}
-
-void Game::showVictoryScreen() {
+void Game::showVictoryScreen(const FrameSnapshot& frame) {
     window.clear(sf::Color(20, 40, 20));
     sf::Text title("VICTORY!", gameFont, 60); 
     title.setPosition(WINDOW_WIDTH / 2 - 150, 150); 
@@ -510,7 +309,7 @@ void Game::showVictoryScreen() {
     window.draw(title);
     
     std::stringstream timeText; 
-    timeText << "Time: " << (int)elapsedTime << " seconds"; 
+    timeText << "Time: " << (int)frame.elapsedTime << " seconds"; 
     sf::Text timeDisplay(timeText.str(), gameFont, 30); 
     timeDisplay.setPosition(WINDOW_WIDTH / 2 - 150, 250); 
     timeDisplay.setFillColor(sf::Color(255, 255, 255)); 
@@ -532,25 +331,42 @@ void Game::showGameOverScreen() {
 }
 
 void Game::startNewGame() {
+    delete sim;
+    sim = nullptr;
+    player = nullptr;
     delete maze; 
-    delete player; 
-    maze = new Maze(COLS, ROWS, CELL_SIZE); 
+    if(!fixedSeed) levelSeed = seedSource.next();
+    std::cout << "Level seed: " << levelSeed << "\n";
+    rng.seed(levelSeed);
+    maze = new Maze(COLS, ROWS, CELL_SIZE, rng.next()); 
+    ++levelId;
+    // The new maze is published whole once, so its versions start past
+    // every change of the old one.
+    levelVersion = mazeChangesFrom + mazeChanges.size() + 1;
+    mazeChangesFrom = levelVersion;
+    mazeChanges.clear();
+    maze->setDirtyList(&mazeChanges);
     currentState = GENERATING; 
-    timer.restart(); 
     elapsedTime = 0;
 }
 
 void Game::handleInput() {
     sf::Event event;
     while(window.pollEvent(event)) {
-        if(event.type == sf::Event::Closed) window.close();
+        if(event.type == sf::Event::Closed) running = false;
+#ifdef PROFILER_ENABLED
+        if(event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) profilerVisible = !profilerVisible;
+        if(event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+            if(Profiler::writeChromeTrace("profile_trace.json")) std::cout << "Wrote profile_trace.json\n";
+        }
+#endif
         if(event.type == sf::Event::KeyPressed) {
             if(currentState == WELCOME) {
                 if(event.key.code == sf::Keyboard::Enter && !playerName.empty()) {
                     startNewGame();
                 }
                 else if(event.key.code == sf::Keyboard::Tab) currentState = LEADERBOARD_VIEW;
-                else if(event.key.code == sf::Keyboard::Escape) window.close();
+                else if(event.key.code == sf::Keyboard::Escape) running = false;
 
             } else if(currentState == LEADERBOARD_VIEW) {
                 if(event.key.code == sf::Keyboard::Escape) currentState = WELCOME;
@@ -561,17 +377,13 @@ void Game::handleInput() {
                 else if(event.key.code == sf::Keyboard::S || event.key.code == sf::Keyboard::Down) moveY = 1;
                 else if(event.key.code == sf::Keyboard::A || event.key.code == sf::Keyboard::Left) moveX = -1;
                 else if(event.key.code == sf::Keyboard::D || event.key.code == sf::Keyboard::Right) moveX = 1;
-                else if(event.key.code == sf::Keyboard::Space) player->fire();
+                else if(event.key.code == sf::Keyboard::Space) sim->fire();
                 else if(event.key.code == sf::Keyboard::G) currentState = GAME_OVER;
                 
                 if(moveX != 0 || moveY != 0) {
-                    bool canMove = maze->canMove(player->getCellX(), player->getCellY(), moveX, moveY);
-                    if(canMove) { 
-                        player->move(moveX, moveY); 
+                    if(sim->movePlayer(moveX, moveY)) { 
                         checkForRiddle(); 
-                        bool reachedExit = (player->getCellX() == maze->getFinishX() && player->getCellY() == maze->getFinishY()); 
-      
-                        if(reachedExit) { 
+                        if(sim->getOutcome() == Simulation::REACHED_EXIT) { 
                             currentState = VICTORY; 
                             addScore(playerName, elapsedTime); 
                         }
@@ -587,6 +399,7 @@ void Game::handleInput() {
                     bool correctAnswer = validIndex && (answer == riddles[currentRiddleIndex]->getAnswer());
                     if(validIndex && correctAnswer) { 
                         riddles[currentRiddleIndex]->setSolved(true);
+                        sim->setRiddleSolved(currentRiddleIndex);
             
                         RiddleRewardType rewardType =
                             riddles[currentRiddleIndex]->getRewardType();
@@ -644,74 +457,499 @@ void Game::handleInput() {
 
 void Game::updateGame() {
     if(currentState == GENERATING) {
-        for(int i = 0; i < 5; i++) maze->step();
+        for(int i = 0; i < GENERATION_STEPS_PER_TICK; i++) maze->step();
         if(!maze->isGenerating()) { 
-            player = new Player(maze->getStartX(), maze->getStartY(), CELL_SIZE, 3.0f); 
+            sim = new Simulation(maze->getGrid(), pathQueue, maze->getStartX(), maze->getStartY(), maze->getFinishX(), maze->getFinishY());
+            player = &sim->getPlayer();
             createRiddles();
-            spawnEnemies();
+            sim->spawnEnemies(rng, rng.range(3, 5));
             currentState = PLAYING; 
-            timer.restart(); 
+            elapsedTime = 0;
         }
     }
     if(currentState == PLAYING) {
-        elapsedTime = timer.getElapsedTime().asSeconds();
-        player->updateBullets(COLS, ROWS, maze);
-        
-        updateEnemies();
-        checkEnemyCollisions();
-        checkBulletCollisions();
-        
-        if(player->getHealth() <= 0) {
+        sim->tick();
+        elapsedTime = sim->getElapsedTime();
+        if(sim->getOutcome() == Simulation::PLAYER_DEAD) {
             currentState = GAME_OVER;
         }
     }
 }
 
-void Game::draw() {
+void Game::drawEnemy(float x, float y) {
+    float px = x * CELL_SIZE + CELL_SIZE / 2;
+    float py = y * CELL_SIZE + CELL_SIZE / 2;
+
+    sf::CircleShape enemyCircle(CELL_SIZE / 3);
+    enemyCircle.setOrigin(CELL_SIZE / 3, CELL_SIZE / 3);
+    enemyCircle.setPosition(px, py);
+    enemyCircle.setFillColor(sf::Color(255, 50, 50));
+    window.draw(enemyCircle);
+
+    sf::CircleShape eye(2);
+    eye.setFillColor(sf::Color(255, 255, 255));
+    eye.setPosition(px - CELL_SIZE / 6, py - CELL_SIZE / 6);
+    window.draw(eye);
+    eye.setPosition(px + CELL_SIZE / 6, py - CELL_SIZE / 6);
+    window.draw(eye);
+
+    sf::RectangleShape mouth(sf::Vector2f(CELL_SIZE / 4, 2));
+    mouth.setPosition(px - CELL_SIZE / 8, py + CELL_SIZE / 8);
+    mouth.setFillColor(sf::Color(255, 255, 255));
+    window.draw(mouth);
+}
+
+void Game::drawAimArrow(const FrameSnapshot& frame) {
+    if(frame.ammo <= 0) return;
+    
+    float px = frame.playerX * CELL_SIZE + CELL_SIZE / 2;
+    float py = frame.playerY * CELL_SIZE + CELL_SIZE / 2;
+    
+    // Calculate arrow direction based on current facing direction
+    int direction = frame.direction;
+    float arrowLength = CELL_SIZE * 2.5f;
+    float dx = 0, dy = 0;
+    
+    if(direction == 0) dy = -arrowLength;       // Up
+    else if(direction == 1) dx = arrowLength;   // Right
+    else if(direction == 2) dy = arrowLength;   // Down
+    else if(direction == 3) dx = -arrowLength;  // Left
+    
+    // Draw arrow line
+    sf::Vertex arrowLine[] = {
+        sf::Vertex(sf::Vector2f(px, py), sf::Color(255, 100, 100)),
+        sf::Vertex(sf::Vector2f(px + dx, py + dy), sf::Color(255, 100, 100))
+    };
+    window.draw(arrowLine, 2, sf::Lines);
+    
+    // Draw arrow head (triangle)
+    float arrowHeadSize = CELL_SIZE * 0.4f;
+    float perpX = -dy / arrowLength * arrowHeadSize;
+    float perpY = dx / arrowLength * arrowHeadSize;
+    
+    sf::Vector2f tipPos(px + dx, py + dy);
+    sf::Vector2f leftBase(px + dx - dx * 0.2f - perpX, py + dy - dy * 0.2f - perpY);
+    sf::Vector2f rightBase(px + dx - dx * 0.2f + perpX, py + dy - dy * 0.2f + perpY);
+    
+    sf::Vertex arrowHead[] = {
+        sf::Vertex(tipPos, sf::Color(255, 100, 100)),
+        sf::Vertex(leftBase, sf::Color(255, 100, 100)),
+        sf::Vertex(rightBase, sf::Color(255, 100, 100)),
+        sf::Vertex(tipPos, sf::Color(255, 100, 100))
+    };
+    window.draw(arrowHead, 4, sf::LineStrip);
+}
+
+void Game::drawPlayer(const FrameSnapshot& frame) {
+    float px = frame.playerX * CELL_SIZE + CELL_SIZE / 2;
+    float py = frame.playerY * CELL_SIZE + CELL_SIZE / 2;
+    
+    sf::CircleShape playerCircle(CELL_SIZE / 3);
+    playerCircle.setOrigin(CELL_SIZE / 3, CELL_SIZE / 3);
+    playerCircle.setPosition(px, py);
+    
+    if(frame.invisible) {
+        playerCircle.setFillColor(sf::Color(100, 100, 255, 150));
+    } else {
+        float health = frame.health;
+        if(health > 2.0f) playerCircle.setFillColor(sf::Color(100, 255, 100));
+        else if(health > 1.0f) playerCircle.setFillColor(sf::Color(255, 255, 100));
+        else playerCircle.setFillColor(sf::Color(255, 100, 100));
+    }
+    
+    window.draw(playerCircle);
+    
+    sf::CircleShape eye(2);
+    eye.setFillColor(sf::Color(0, 0, 0));
+    eye.setPosition(px - CELL_SIZE / 6, py - CELL_SIZE / 6);
+    window.draw(eye);
+    eye.setPosition(px + CELL_SIZE / 6, py - CELL_SIZE / 6);
+    window.draw(eye);
+    
+    float health = frame.health;
+    if(health > 2.0f) {
+        sf::VertexArray smile(sf::LinesStrip, 4);
+        smile[0].position = sf::Vector2f(px - CELL_SIZE/6, py + CELL_SIZE/8);
+        smile[1].position = sf::Vector2f(px - CELL_SIZE/6, py + CELL_SIZE/4);
+        smile[2].position = sf::Vector2f(px + CELL_SIZE/6, py + CELL_SIZE/4);
+        smile[3].position = sf::Vector2f(px + CELL_SIZE/6, py + CELL_SIZE/8);
+        for(int i=0; i<4; ++i) smile[i].color = sf::Color::Black;
+        window.draw(smile);
+    } else if(health > 1.0f) {
+        sf::RectangleShape mouth(sf::Vector2f(CELL_SIZE / 3, 2));
+        mouth.setPosition(px - CELL_SIZE / 6, py + CELL_SIZE / 6);
+        mouth.setFillColor(sf::Color(0, 0, 0));
+        window.draw(mouth);
+    } else {
+        sf::VertexArray frown(sf::LinesStrip, 4);
+        frown[0].position = sf::Vector2f(px - CELL_SIZE/6, py + CELL_SIZE/4);
+        frown[1].position = sf::Vector2f(px - CELL_SIZE/6, py + CELL_SIZE/8);
+        frown[2].position = sf::Vector2f(px + CELL_SIZE/6, py + CELL_SIZE/8);
+        frown[3].position = sf::Vector2f(px + CELL_SIZE/6, py + CELL_SIZE/4);
+        for(int i=0; i<4; ++i) frown[i].color = sf::Color::Black;
+        window.draw(frown);
+    }
+    
+    TileRange tiles = visibleTiles();
+    for(const auto& bullet : frame.bullets) {
+        float bx = bullet.prevX + (bullet.x - bullet.prevX) * renderAlpha;
+        float by = bullet.prevY + (bullet.y - bullet.prevY) * renderAlpha;
+        if(!tiles.overlaps(bx, by)) continue;
+        sf::RectangleShape bulletShape(sf::Vector2f(CELL_SIZE * 0.3f, CELL_SIZE * 0.3f));
+        bulletShape.setOrigin(CELL_SIZE * 0.15f, CELL_SIZE * 0.15f);
+        bulletShape.setPosition(bx * CELL_SIZE + CELL_SIZE / 2, by * CELL_SIZE + CELL_SIZE / 2);
+        bulletShape.setFillColor(sf::Color(255, 255, 255));
+        window.draw(bulletShape);
+    }
+}
+
+// Centres the camera on the player, or on the cell being carved while
+// generating, without showing space past the maze edges. A maze smaller than
+// the view is centred instead. Whole pixels keep the walls crisp.
+void Game::updateCamera(const FrameSnapshot& frame) {
+    float focusX = frame.playerX;
+    float focusY = frame.playerY;
+    if(frame.state == GENERATING) {
+        if(frame.generatingCell < 0) return;
+        focusX = static_cast<float>(frame.generatingCell % COLS);
+        focusY = static_cast<float>(frame.generatingCell / COLS);
+    }
+    auto clampAxis = [](float center, float view, float world) {
+        if(world <= view) return world / 2;
+        return std::min(std::max(center, view / 2), world - view / 2);
+    };
+    sf::Vector2f size = camera.getSize();
+    float x = clampAxis((focusX + 0.5f) * CELL_SIZE, size.x, static_cast<float>(COLS * CELL_SIZE));
+    float y = clampAxis((focusY + 0.5f) * CELL_SIZE, size.y, static_cast<float>(ROWS * CELL_SIZE));
+    camera.setCenter(std::round(x), std::round(y));
+}
+
+TileRange Game::visibleTiles() const {
+    sf::Vector2f size = camera.getSize();
+    float left = camera.getCenter().x - size.x / 2;
+    float top = camera.getCenter().y - size.y / 2;
+    TileRange range;
+    range.minX = std::max(0, static_cast<int>(std::floor(left / CELL_SIZE)));
+    range.minY = std::max(0, static_cast<int>(std::floor(top / CELL_SIZE)));
+    range.maxX = std::min(COLS - 1, static_cast<int>(std::ceil((left + size.x) / CELL_SIZE)) - 1);
+    range.maxY = std::min(ROWS - 1, static_cast<int>(std::ceil((top + size.y) / CELL_SIZE)) - 1);
+    return range;
+}
+
+// Brings the render-side maze mesh up to date with the snapshot. A new level
+// rebuilds it from the whole grid; after that only the changed cells the
+// snapshot lists are re-uploaded.
+void Game::syncMazeView(const FrameSnapshot& frame) {
+    if(frame.mazeVersion == 0 || frame.mazeVersion == mazeViewVersion.load(std::memory_order_relaxed)) return;
+    if(!frame.cells.empty()) {
+        if(!mazeView || mazeViewLevel != frame.levelId) {
+            delete mazeView;
+            mazeView = new MazeRenderer(COLS, ROWS, CELL_SIZE);
+            mazeViewLevel = frame.levelId;
+        }
+        for(size_t i = 0; i < frame.cells.size(); ++i) updateMazeViewCell(frame, i, frame.cells[i]);
+    } else {
+        // Changes are only published once this level's grid was applied.
+        for(size_t c = 0; c < frame.changedCells.size(); ++c) updateMazeViewCell(frame, frame.changedCells[c], frame.changedBits[c]);
+    }
+    mazeViewVersion.store(frame.mazeVersion, std::memory_order_release);
+}
+
+void Game::updateMazeViewCell(const FrameSnapshot& frame, size_t index, unsigned char bits) {
+    int x = static_cast<int>(index % COLS);
+    int y = static_cast<int>(index / COLS);
+    bool isStart = (x == frame.startX && y == frame.startY);
+    bool isFinish = (x == frame.finishX && y == frame.finishY);
+    mazeView->updateCell(Cell(x, y, bits), isStart, isFinish);
+}
+
+void Game::draw(const FrameSnapshot& frame) {
+    PROFILE_SCOPE(Profiler::DRAW);
     window.clear(sf::Color(10, 10, 20));
-    if(currentState == WELCOME) showWelcomeScreen();
-    else if(currentState == LEADERBOARD_VIEW) showLeaderboard();
-    else if(currentState == GENERATING) maze->draw(window);
-    else if(currentState == PLAYING || currentState == RIDDLE_ACTIVE) {
-        sf::RectangleShape darkness(sf::Vector2f(MAZE_WIDTH, MAZE_HEIGHT)); 
-        darkness.setFillColor(sf::Color(0, 0, 0, 220)); 
-        window.draw(darkness);
-        
-        maze->drawWithVision(window, *player);
+    GameState state = frame.state;
+    if(state == GENERATING || state == PLAYING || state == RIDDLE_ACTIVE) syncMazeView(frame);
+
+    if(state == WELCOME) showWelcomeScreen(frame);
+    else if(state == LEADERBOARD_VIEW) showLeaderboard(frame);
+    else if(state == GENERATING) {
+        PROFILE_SCOPE(Profiler::DRAW_MAZE);
+        updateCamera(frame);
+        window.setView(camera);
+        TileRange tiles = visibleTiles();
+        if(mazeView) mazeView->drawRange(window, tiles.minX, tiles.minY, tiles.maxX, tiles.maxY);
+        if(frame.generatingCell >= 0) {
+            sf::RectangleShape highlight(sf::Vector2f(CELL_SIZE - 4, CELL_SIZE - 4));
+            highlight.setPosition((frame.generatingCell % COLS) * CELL_SIZE + 2, (frame.generatingCell / COLS) * CELL_SIZE + 2);
+            highlight.setFillColor(sf::Color(100,200,255));
+            window.draw(highlight);
+        }
+        window.setView(window.getDefaultView());
+    }
+    else if(state == PLAYING || state == RIDDLE_ACTIVE) {
+        updateCamera(frame);
+        window.setView(camera);
+        {
+            PROFILE_SCOPE(Profiler::DRAW_MAZE);
+            if(!fog) fog = new FogOfWar(COLS, ROWS, CELL_SIZE, MAZE_WIDTH, MAZE_HEIGHT);
+            if(fog->isReady() && mazeView) {
+                if(fogLevel != frame.levelId) {
+                    fog->reset(*mazeView);
+                    fogLevel = frame.levelId;
+                }
+                fog->reveal(frame.visibleCells, frame.visibilityX, frame.visibilityY, frame.visibilityRadius);
+                fog->draw(window, camera, frame.visibleCells, frame.playerX, frame.playerY, frame.visionRadius);
+            } else {
+                sf::RectangleShape darkness(camera.getSize()); 
+                darkness.setPosition(camera.getCenter() - camera.getSize() / 2.0f);
+                darkness.setFillColor(sf::Color(0, 0, 0, 220)); 
+                window.draw(darkness);
+                
+                if(mazeView) mazeView->drawCells(window, frame.visibleCells);
+            }
+        }
         
-        for(const auto& e : enemies) {
-            bool canSeeEnemy = player->isInVision(e->getX(), e->getY());
-            if(canSeeEnemy) e->draw(window);
+        PROFILE_SCOPE(Profiler::DRAW_ENTITIES);
+        TileRange tiles = visibleTiles();
+        for(std::uint32_t i : frame.visibleEnemies) {
+            float ex = frame.enemyPrevXs[i] + (frame.enemyXs[i] - frame.enemyPrevXs[i]) * renderAlpha;
+            float ey = frame.enemyPrevYs[i] + (frame.enemyYs[i] - frame.enemyPrevYs[i]) * renderAlpha;
+            if(tiles.overlaps(ex, ey)) drawEnemy(ex, ey);
         }
         
-        showRiddleMarkers();
-        player->draw(window);
-        player->drawAimArrow(window, CELL_SIZE);
+        showRiddleMarkers(frame);
+        drawPlayer(frame);
+        drawAimArrow(frame);
         
-        float visionSize = player->getVisionRadius() * CELL_SIZE;
+        float visionSize = frame.visionRadius * CELL_SIZE;
         sf::CircleShape visionCircle(visionSize); 
         visionCircle.setOrigin(visionSize, visionSize);
-        visionCircle.setPosition(player->getCellX() * CELL_SIZE + CELL_SIZE / 2, player->getCellY() * CELL_SIZE + CELL_SIZE / 2);
+        visionCircle.setPosition(static_cast<int>(std::round(frame.playerX)) * CELL_SIZE + CELL_SIZE / 2, static_cast<int>(std::round(frame.playerY)) * CELL_SIZE + CELL_SIZE / 2);
         visionCircle.setFillColor(sf::Color(255, 255, 255, 5)); 
         visionCircle.setOutlineColor(sf::Color(255, 255, 150, 30)); 
         visionCircle.setOutlineThickness(2); 
         window.draw(visionCircle);
+        window.setView(window.getDefaultView());
+    } else if(state == VICTORY) showVictoryScreen(frame);
+    else if(state == GAME_OVER) showGameOverScreen();
+
+    if(state == PLAYING || state == RIDDLE_ACTIVE) {
+        PROFILE_SCOPE(Profiler::DRAW_HUD);
+        hud.drawGameInfo(window, frame);
+        hud.drawMiniLeaderboard(window, frame);
+        hud.drawHealthBar(window, frame);
         
-        showGameInfo(); 
-        showMiniLeaderboard();
-        showHealthBar();
-        
-        if(currentState == RIDDLE_ACTIVE) showRiddleBox();
-    } else if(currentState == VICTORY) showVictoryScreen();
-    else if(currentState == GAME_OVER) showGameOverScreen();
-    
-    window.display();
+        if(state == RIDDLE_ACTIVE) hud.drawRiddleBox(window, frame);
+    }
+#ifdef PROFILER_ENABLED
+    if(frame.showProfiler) showProfiler();
+#endif
 }
 
+#ifdef PROFILER_ENABLED
+// p50/p99 per section over the last Profiler::HISTORY frames. The text is
+// refreshed a few times per second so the numbers stay readable.
+void Game::showProfiler() {
+    if(profilerRefresh-- <= 0) {
+        profilerRefresh = RENDER_FPS / 4;
+        std::stringstream text;
+        text << "section          p50 ms   p99 ms\n";
+        for(int s = 0; s < Profiler::SECTION_COUNT; ++s) {
+            Profiler::Stats stats = Profiler::stats(static_cast<Profiler::Section>(s));
+            char line[64];
+            std::snprintf(line, sizeof(line), "%-14s %8.3f %8.3f\n", Profiler::sectionName(static_cast<Profiler::Section>(s)), stats.p50Ms, stats.p99Ms);
+            text << line;
+        }
+        text << "F3 hide | F4 write profile_trace.json";
+        profilerText.setString(text.str());
+    }
+
+    sf::FloatRect bounds = profilerText.getGlobalBounds();
+    sf::RectangleShape box(sf::Vector2f(bounds.width + 16, bounds.height + 16));
+    box.setPosition(bounds.left - 8, bounds.top - 8);
+    box.setFillColor(sf::Color(0, 0, 0, 200));
+    window.draw(box);
+    window.draw(profilerText);
+}
+#endif
+
+std::string Game::rewardText(const Riddle& riddle) const {
+    std::stringstream text;
+    RiddleRewardType rt = riddle.getRewardType();
+
+    if (rt == VISION_REWARD) {
+        text << "Reward: +" << riddle.getReward()
+             << " vision";
+
+    } else if (rt == INVISIBILITY_REWARD) {
+        text << "Reward: Invisibility";
+
+    } else if (rt == KILL_POWER_REWARD) {
+        text << "Reward: Kill Power + 6 Ammo";
+
+    } else if (rt == HEALTH_REWARD) {
+        text << "Reward: +" << riddle.getReward() << " health";
+    }
+    return text.str();
+}
+
+// Copies everything draw() needs into the back snapshot and hands it to the
+// render thread. Vectors keep their capacity across frames, so this does not
+// allocate once a level is running.
+void Game::publishSnapshot() {
+    FrameSnapshot& frame = snapshots.writeSlot();
+    frame.state = currentState;
+    frame.publishedAt = std::chrono::steady_clock::now();
+    frame.alphaAtPublish = accumulator / Simulation::TICK_SECONDS;
+    frame.ticksPerSecond = timeScale / Simulation::TICK_SECONDS;
+
+    frame.levelId = levelId;
+    if(maze) {
+        const MazeGrid& grid = maze->getGrid();
+        frame.startX = maze->getStartX();
+        frame.startY = maze->getStartY();
+        frame.finishX = maze->getFinishX();
+        frame.finishY = maze->getFinishY();
+        // Changes the render thread has drawn are dropped; the rest go out
+        // with their current bits, or the whole grid until it has drawn this
+        // level at all.
+        std::uint64_t drawn = mazeViewVersion.load(std::memory_order_acquire);
+        frame.cells.clear();
+        frame.changedCells.clear();
+        frame.changedBits.clear();
+        if(drawn < levelVersion) {
+            frame.cells.assign(grid.rowData(0), grid.rowData(0) + grid.size());
+        } else {
+            mazeChanges.erase(mazeChanges.begin(), mazeChanges.begin() + static_cast<std::ptrdiff_t>(drawn - mazeChangesFrom));
+            mazeChangesFrom = drawn;
+            for(size_t cell : mazeChanges) {
+                frame.changedCells.push_back(cell);
+                frame.changedBits.push_back(grid.bits(cell));
+            }
+        }
+        frame.mazeVersion = mazeChangesFrom + mazeChanges.size();
+        frame.generatingCell = maze->isGenerating() ? static_cast<long>(maze->getCurrentCell()) : -1;
+    } else {
+        frame.mazeVersion = 0;
+        frame.cells.clear();
+        frame.changedCells.clear();
+        frame.changedBits.clear();
+        frame.generatingCell = -1;
+    }
+
+    frame.bullets.clear();
+    frame.enemyXs.clear();
+    frame.enemyYs.clear();
+    frame.enemyPrevXs.clear();
+    frame.enemyPrevYs.clear();
+    frame.visibleCells.clear();
+    frame.visibleEnemies.clear();
+    frame.riddles.clear();
+    frame.solvedRiddles = 0;
+    if(sim) {
+        frame.playerX = player->getX();
+        frame.playerY = player->getY();
+        frame.visionRadius = player->getVisionRadius();
+        frame.health = player->getHealth();
+        frame.maxHealth = player->getMaxHealth();
+        frame.ammo = player->getAmmo();
+        frame.direction = player->getDirection();
+        frame.invisible = player->getIsInvisible();
+        const BulletPool& bullets = player->getBullets();
+        for(size_t i = 0; i < bullets.size(); ++i) {
+            if(bullets[i].active) frame.bullets.push_back(bullets[i]);
+        }
+
+        const EnemyStore& enemies = sim->getEnemies();
+        frame.enemyXs.assign(enemies.getXs(), enemies.getXs() + enemies.size());
+        frame.enemyYs.assign(enemies.getYs(), enemies.getYs() + enemies.size());
+        frame.enemyPrevXs.assign(enemies.getPrevXs(), enemies.getPrevXs() + enemies.size());
+        frame.enemyPrevYs.assign(enemies.getPrevYs(), enemies.getPrevYs() + enemies.size());
+
+        const Visibility& visibility = sim->getVisibility();
+        frame.visibilityX = visibility.getOriginX();
+        frame.visibilityY = visibility.getOriginY();
+        frame.visibilityRadius = player->getVisionRadius();
+        const MazeGrid& grid = maze->getGrid();
+        for(size_t cell : visibility.getVisibleCells()) {
+            if(sim->canPlayerSee(grid.cellX(cell), grid.cellY(cell))) frame.visibleCells.push_back(cell);
+        }
+        visibleMask.resize(RangeKernels::maskWords(enemies.size()));
+        RangeKernels::withinRadius(enemies.getXs(), enemies.getYs(), enemies.size(), player->getX(), player->getY(), player->getVisionRadius(), visibleMask.data());
+        RangeKernels::forEachSet(visibleMask.data(), enemies.size(), [&](std::size_t i) {
+            if(visibility.isVisible(enemies.getCellX(i), enemies.getCellY(i))) frame.visibleEnemies.push_back(static_cast<std::uint32_t>(i));
+        });
+
+        for(const Riddle* r : riddles) {
+            frame.riddles.push_back(RiddleView{r->getX(), r->getY(), r->isSolved(), sim->canPlayerSee(static_cast<int>(r->getX()), static_cast<int>(r->getY())), r->getMarkerColor()});
+            if(r->isSolved()) ++frame.solvedRiddles;
+        }
+    }
+
+    frame.riddleQuestion.clear();
+    frame.riddleReward.clear();
+    if(currentState == RIDDLE_ACTIVE && currentRiddleIndex >= 0 && currentRiddleIndex < (int)riddles.size()) {
+        frame.riddleQuestion = riddles[currentRiddleIndex]->getQuestion();
+        frame.riddleReward = rewardText(*riddles[currentRiddleIndex]);
+    }
+    frame.playerName = playerName;
+    frame.playerAnswer = playerAnswer;
+    frame.elapsedTime = elapsedTime;
+    if(frame.leaderboardVersion != leaderboardVersion) {
+        frame.leaderboard = leaderboard;
+        frame.leaderboardVersion = leaderboardVersion;
+    }
+#ifdef PROFILER_ENABLED
+    frame.showProfiler = profilerVisible;
+#endif
+    snapshots.publish();
+}
+
+// Draws the newest snapshot at the display rate. Interpolation continues from
+// the accumulator at publish time, so motion stays smooth between ticks.
+void Game::renderLoop() {
+    window.setActive(true);
+    while(running) {
+        snapshots.acquire();
+        const FrameSnapshot& frame = snapshots.readSlot();
+        float sincePublish = std::chrono::duration<float>(std::chrono::steady_clock::now() - frame.publishedAt).count();
+        renderAlpha = std::min(1.0f, frame.alphaAtPublish + sincePublish * frame.ticksPerSecond);
+        draw(frame);
+        PROFILE_END_FRAME(Profiler::DRAW, Profiler::DRAW_HUD);
+        window.display();
+    }
+    window.setActive(false);
+}
+
+// The window's events must be polled on the thread that created it, so input
+// and simulation stay here; drawing runs on its own thread from snapshots.
 void Game::run() {
-    while(window.isOpen()) { 
-        handleInput(); 
-        updateGame(); 
-        draw(); 
+    window.setActive(false);
+    running = true;
+    publishSnapshot();
+    std::thread renderThread(&Game::renderLoop, this);
+
+    frameClock.restart();
+    while(running) { 
+        {
+            PROFILE_SCOPE(Profiler::INPUT);
+            handleInput(); 
+        }
+
+        // Clamp long frames (window drags, breakpoints) so the simulation
+        // does not try to catch up all at once.
+        float frameSeconds = std::min(frameClock.restart().asSeconds(), MAX_FRAME_SECONDS);
+        accumulator += frameSeconds * timeScale;
+        while(accumulator >= Simulation::TICK_SECONDS) {
+            PROFILE_SCOPE(Profiler::UPDATE);
+            updateGame();
+            accumulator -= Simulation::TICK_SECONDS;
+        }
+        publishSnapshot();
+        PROFILE_END_FRAME(Profiler::INPUT, Profiler::COLLISIONS);
+
+        sf::sleep(sf::seconds((Simulation::TICK_SECONDS - accumulator) / timeScale));
     }
-}
\ No newline at end of file
+
+    renderThread.join();
+    window.close();
+}
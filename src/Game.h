@@ -4,12 +4,21 @@
 #include "Maze.h"
 #include "Player.h"
 #include "Riddle.h"
-#include "Enemy.h"
 #include "GameObject.h"
+#include "Rng.h"
+#include "Simulation.h"
+#include "MazeRenderer.h"
+#include "FogOfWar.h"
+#include "TripleBuffer.h"
+#include "Hud.h"
+#include "Profiler.h"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
 
 enum GameState { WELCOME, GENERATING, PLAYING, RIDDLE_ACTIVE, GAME_OVER, VICTORY, LEADERBOARD_VIEW };
 
@@ -21,6 +30,72 @@ struct LeaderboardEntry {
     bool operator<(const LeaderboardEntry& other) const { return time < other.time; } 
 };
 
+struct RiddleView {
+    float x, y;
+    bool solved;
+    bool visible; // in the player's line of sight
+    sf::Color color;
+};
+
+// Everything the render thread needs for one frame, copied from the game
+// state after each tick. The render thread reads nothing else, so the
+// simulation never waits on drawing.
+struct FrameSnapshot {
+    GameState state;
+    // Tick positions are interpolated from the publish time onward.
+    std::chrono::steady_clock::time_point publishedAt;
+    float alphaAtPublish;
+    float ticksPerSecond;
+
+    // Maze cells change while generating; levelId changes with every new maze.
+    // cells holds the whole grid until the render thread has drawn this
+    // level, then stays empty and changedCells / changedBits carry only the
+    // cells changed since the mazeVersion it last drew. mazeVersion is 0
+    // without a maze.
+    std::uint64_t levelId;
+    std::uint64_t mazeVersion;
+    int startX, startY, finishX, finishY;
+    std::vector<unsigned char> cells;
+    std::vector<size_t> changedCells;
+    std::vector<unsigned char> changedBits;
+    long generatingCell; // -1 once generation is done
+
+    float playerX, playerY;
+    float visionRadius, health, maxHealth;
+    int ammo, direction;
+    bool invisible;
+    std::vector<Bullet> bullets;
+    std::vector<float> enemyXs, enemyYs, enemyPrevXs, enemyPrevYs;
+    // Cells and enemies in the player's line of sight and vision radius.
+    // visibleCells only changes when visibilityX/Y/Radius do.
+    std::vector<size_t> visibleCells;
+    int visibilityX, visibilityY;
+    float visibilityRadius;
+    std::vector<std::uint32_t> visibleEnemies;
+    std::vector<RiddleView> riddles;
+    int solvedRiddles;
+
+    std::string riddleQuestion, riddleReward;
+    std::string playerName, playerAnswer;
+    float elapsedTime;
+    // Copied only when leaderboardVersion changes.
+    std::uint64_t leaderboardVersion;
+    std::vector<LeaderboardEntry> leaderboard;
+    bool showProfiler;
+
+    FrameSnapshot() : state(WELCOME), alphaAtPublish(0), ticksPerSecond(0), levelId(0), mazeVersion(0), startX(0), startY(0), finishX(0), finishY(0),
+        generatingCell(-1), playerX(0), playerY(0), visionRadius(0), health(0), maxHealth(1), ammo(0), direction(0), invisible(false), visibilityX(-1), visibilityY(-1), visibilityRadius(0),
+        solvedRiddles(0), elapsedTime(0), leaderboardVersion(0), showProfiler(false) {}
+};
+
+// Inclusive cell range, e.g. the tiles under the camera.
+struct TileRange {
+    int minX, minY, maxX, maxY;
+    // Something drawn around (x, y) may reach into the range; the margin
+    // covers sprites up to a cell past their own.
+    bool overlaps(float x, float y) const { return x + 1 >= minX && x - 1 <= maxX && y + 1 >= minY && y - 1 <= maxY; }
+};
+
 class Game {
 private:
     static const int CELL_SIZE = 25;
@@ -30,18 +105,65 @@ private:
     static const int MAZE_HEIGHT = 500;
     static const int WINDOW_WIDTH = 1000;
     static const int WINDOW_HEIGHT = 700;
+    // Simulation advances in fixed ticks (Simulation::TICK_RATE); rendering
+    // runs at its own rate and interpolates between the last two ticks.
+    static constexpr float MAX_FRAME_SECONDS = 0.25f;
+    static const int RENDER_FPS = 60;
+    static const int GENERATION_STEPS_PER_TICK = 3;
 
     sf::RenderWindow window;
     GameState currentState;
     Maze* maze;
+    // Gameplay state of the current level; created once the maze is done.
+    // player points into it and is null while there is no simulation.
+    Simulation* sim;
+    // Route workers shared by every level's simulation.
+    PathQueue pathQueue;
     Player* player;
     std::vector<Riddle*> riddles;
-    std::vector<Enemy*> enemies;
     std::vector<LeaderboardEntry> leaderboard;
+    std::uint64_t leaderboardVersion; // bumped whenever leaderboard changes
     int currentRiddleIndex;
     std::string playerAnswer;
-    sf::Clock timer;
-    float elapsedTime;
+    sf::Clock frameClock;
+    float accumulator;
+    float timeScale;
+    float elapsedTime; // simulation seconds since the level started
+    std::uint64_t levelId;
+    // Maze versions count cell changes: mazeChanges holds, in order, the
+    // cells changed from version mazeChangesFrom on, as the generator
+    // reports them. Versions keep rising across levels; levelVersion is the
+    // first one of the current maze.
+    std::vector<size_t> mazeChanges;
+    std::uint64_t mazeChangesFrom;
+    std::uint64_t levelVersion;
+    // Scratch bitmask written by the batch vision tests.
+    std::vector<std::uint32_t> visibleMask;
+#ifdef PROFILER_ENABLED
+    bool profilerVisible; // F3
+#endif
+
+    // Input and simulation run on the thread that owns the window's events;
+    // drawing runs on renderThread from snapshots, which it acquires without
+    // locking. Members below the snapshots belong to the render thread.
+    TripleBuffer<FrameSnapshot> snapshots;
+    std::atomic<bool> running;
+    MazeRenderer* mazeView;
+    std::uint64_t mazeViewLevel;
+    // Maze version mazeView is up to date with. Written by the render thread;
+    // publishSnapshot() reads it to send only the changes after it.
+    std::atomic<std::uint64_t> mazeViewVersion;
+    // Follows the player over the maze area of the window; world drawing
+    // is limited to the tiles under it.
+    sf::View camera;
+    FogOfWar* fog;
+    std::uint64_t fogLevel; // level whose finished maze is baked into fog
+    float renderAlpha;
+    Hud hud;
+#ifdef PROFILER_ENABLED
+    sf::Text profilerText;
+    int profilerRefresh;
+#endif
     sf::Font gameFont;
     bool playerDeadThisFrame;
 
@@ -57,32 +179,51 @@ private:
     std::string playerName;
     GameState previousState;
 
+    // Every level is built from one seed; rng drives maze, riddle and enemy
+    // placement for that level. seedSource picks new level seeds unless a
+    // fixed seed was requested.
+    Rng rng;
+    Rng seedSource;
+    std::uint64_t levelSeed;
+    bool fixedSeed;
+
     void createRiddles();
-    void spawnEnemies();
-    void updateEnemies();
-    void checkEnemyCollisions();
-    void checkBulletCollisions();
+    std::string rewardText(const Riddle& riddle) const;
+    void publishSnapshot();
+
+    // Render thread.
+    void renderLoop();
+    void syncMazeView(const FrameSnapshot& frame);
+    void updateMazeViewCell(const FrameSnapshot& frame, size_t index, unsigned char bits);
+    void updateCamera(const FrameSnapshot& frame);
+    TileRange visibleTiles() const;
+    void drawEnemy(float x, float y);
+    void drawPlayer(const FrameSnapshot& frame);
+    void drawAimArrow(const FrameSnapshot& frame);
+#ifdef PROFILER_ENABLED
+    void showProfiler();
+#endif
     void loadScores();
     void saveScores();
     void addScore(const std::string& name, float time);
     void checkForRiddle();
-    void showWelcomeScreen();
-    void showLeaderboard();
-    void showMiniLeaderboard();
-    void showRiddleBox();
-    void showGameInfo();
-    void showHealthBar();
-    void showRiddleMarkers();
-    void showVictoryScreen();
+    void showWelcomeScreen(const FrameSnapshot& frame);
+    void showLeaderboard(const FrameSnapshot& frame);
+    void showRiddleMarkers(const FrameSnapshot& frame);
+    void showVictoryScreen(const FrameSnapshot& frame);
     void showGameOverScreen();
 
 public:
     Game();
     ~Game();
+    void setSeed(std::uint64_t seed);
+    // Simulated seconds per real second; above 1 runs faster than real time.
+    void setTimeScale(float scale);
     void startNewGame();
     void handleInput();
+    // Advances the simulation by one fixed tick.
     void updateGame();
-    void draw();
+    void draw(const FrameSnapshot& frame);
     void run();
 };
 
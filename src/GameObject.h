@@ -1,15 +1,14 @@
 #ifndef GAMEOBJECT_H
 #define GAMEOBJECT_H
 
-#include <SFML/Graphics.hpp>
-
+// No SFML dependency: drawing lives with the renderer (Game, Riddle), so the
+// simulation can run headless.
 class GameObject {
 protected:
     float x, y;
 public:
     GameObject(float posX = 0, float posY = 0);
     virtual ~GameObject();
-    virtual void draw(sf::RenderWindow& window) const = 0;
     virtual void update(float deltaTime);
     float getX() const;
     float getY() const;
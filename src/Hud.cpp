@@ -0,0 +1,151 @@
+#include "Hud.h"
+#include "Game.h"
+#include <algorithm>
+#include <sstream>
+
+HudText::HudText() : key(0), hasKey(false) {}
+
+void HudText::setup(const sf::Font& font, unsigned size, sf::Color color, float x, float y) {
+    text.setFont(font);
+    text.setCharacterSize(size);
+    text.setFillColor(color);
+    text.setPosition(x, y);
+}
+
+void HudText::setString(const std::string& s) {
+    if(s == shown) return;
+    shown = s;
+    text.setString(s);
+}
+
+Hud::Hud(float mazeWidth_, float mazeHeight_) : mazeWidth(mazeWidth_), mazeHeight(mazeHeight_), shownHealth(-1), shownMaxHealth(-1) {
+    healthBg.setSize(sf::Vector2f(250, 30));
+    healthBg.setPosition(20, mazeHeight + 20);
+    healthBg.setFillColor(sf::Color(50, 50, 50));
+    healthBg.setOutlineColor(sf::Color(100, 100, 100));
+    healthBg.setOutlineThickness(2);
+    healthFill.setPosition(20, mazeHeight + 20);
+
+    miniBox.setSize(sf::Vector2f(220, 300));
+    miniBox.setPosition(mazeWidth + 20, 20);
+    miniBox.setFillColor(sf::Color(30, 30, 50, 200));
+    miniBox.setOutlineColor(sf::Color(100, 100, 120));
+    miniBox.setOutlineThickness(2);
+
+    riddleBox.setSize(sf::Vector2f(mazeWidth - 40, 150));
+    riddleBox.setPosition(20, mazeHeight + 20);
+    riddleBox.setFillColor(sf::Color(40, 40, 70, 230));
+    riddleBox.setOutlineColor(sf::Color(255, 220, 100));
+    riddleBox.setOutlineThickness(3);
+
+    inputBox.setSize(sf::Vector2f(mazeWidth - 80, 40));
+    inputBox.setPosition(40, mazeHeight + 90);
+    inputBox.setFillColor(sf::Color(20, 20, 40));
+    inputBox.setOutlineColor(sf::Color(100, 100, 150));
+    inputBox.setOutlineThickness(2);
+}
+
+void Hud::setFont(const sf::Font& font) {
+    timeLabel.setup(font, 20, sf::Color(255, 220, 100), 20, mazeHeight + 180);
+    riddleLabel.setup(font, 20, sf::Color(200, 200, 255), 180, mazeHeight + 180);
+    visionLabel.setup(font, 20, sf::Color(150, 255, 150), 380, mazeHeight + 180);
+    ammoLabel.setup(font, 20, sf::Color(255, 200, 100), 550, mazeHeight + 180);
+
+    healthLabel.setup(font, 14, sf::Color(255, 255, 255), 30, mazeHeight + 26);
+
+    miniTitle.setup(font, 18, sf::Color(255, 220, 100), mazeWidth + 40, 30);
+    miniTitle.setString("Current Leaderboard");
+    for(int i = 0; i < MINI_LEADERBOARD_ROWS; ++i) {
+        miniEntries[i].setup(font, 14, sf::Color(200, 200, 200), mazeWidth + 35, 70 + 35 * i);
+    }
+
+    question.setup(font, 16, sf::Color(255, 255, 255), 40, mazeHeight + 35);
+    reward.setup(font, 14, sf::Color(150, 255, 150), 40, mazeHeight + 60);
+    answer.setup(font, 18, sf::Color(200, 200, 200), 50, mazeHeight + 100);
+    hint.setup(font, 12, sf::Color(150, 150, 150), 40, mazeHeight + 145);
+    hint.setString("Press ENTER to submit | ESC to close");
+}
+
+void Hud::drawGameInfo(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    int seconds = (int)frame.elapsedTime;
+    timeLabel.update(seconds, [&]() {
+        std::stringstream text;
+        text << "Time: " << seconds << "s";
+        return text.str();
+    });
+    std::int64_t total = (std::int64_t)frame.riddles.size();
+    riddleLabel.update(((std::int64_t)frame.solvedRiddles << 32) | total, [&]() {
+        std::stringstream text;
+        text << "Riddles: " << frame.solvedRiddles << "/" << total;
+        return text.str();
+    });
+    int vision = (int)frame.visionRadius;
+    visionLabel.update(vision, [&]() {
+        std::stringstream text;
+        text << "Vision: " << vision;
+        return text.str();
+    });
+    ammoLabel.update(frame.ammo, [&]() {
+        std::stringstream text;
+        text << "Ammo: " << frame.ammo;
+        return text.str();
+    });
+
+    timeLabel.draw(window);
+    riddleLabel.draw(window);
+    visionLabel.draw(window);
+    ammoLabel.draw(window);
+}
+
+void Hud::drawHealthBar(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    if(frame.health != shownHealth || frame.maxHealth != shownMaxHealth) {
+        shownHealth = frame.health;
+        shownMaxHealth = frame.maxHealth;
+        healthFill.setSize(sf::Vector2f(250 * (frame.health / frame.maxHealth), 30));
+        if(frame.health > 2.0f) healthFill.setFillColor(sf::Color(0, 255, 0));
+        else if(frame.health > 1.0f) healthFill.setFillColor(sf::Color(255, 255, 0));
+        else healthFill.setFillColor(sf::Color(255, 0, 0));
+    }
+    int health = (int)frame.health;
+    int maxHealth = (int)frame.maxHealth;
+    healthLabel.update(((std::int64_t)health << 32) | (std::uint32_t)maxHealth, [&]() {
+        std::stringstream text;
+        text << "HP: " << health << "/" << maxHealth;
+        return text.str();
+    });
+
+    window.draw(healthBg);
+    window.draw(healthFill);
+    healthLabel.draw(window);
+}
+
+void Hud::drawMiniLeaderboard(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    const std::vector<LeaderboardEntry>& leaderboard = frame.leaderboard;
+    int miniEntryCount = (int)std::min(leaderboard.size(), (size_t)MINI_LEADERBOARD_ROWS);
+    for(int i = 0; i < miniEntryCount; ++i) {
+        miniEntries[i].update((std::int64_t)frame.leaderboardVersion, [&]() {
+            std::stringstream text;
+            text << (i + 1) << ". " << leaderboard[i].name.substr(0, 8) << " " << (int)leaderboard[i].time << "s";
+            return text.str();
+        });
+    }
+
+    window.draw(miniBox);
+    miniTitle.draw(window);
+    for(int i = 0; i < miniEntryCount; ++i) miniEntries[i].draw(window);
+}
+
+void Hud::drawRiddleBox(sf::RenderWindow& window, const FrameSnapshot& frame) {
+    window.draw(riddleBox);
+    if(frame.riddleQuestion.empty()) return;
+
+    question.setString(frame.riddleQuestion);
+    reward.setString(frame.riddleReward);
+    answer.setString("Answer: " + frame.playerAnswer + "_");
+
+    question.draw(window);
+    reward.draw(window);
+    window.draw(inputBox);
+    answer.draw(window);
+    hint.draw(window);
+}
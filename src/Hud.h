@@ -0,0 +1,69 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+
+struct FrameSnapshot;
+
+// One HUD label kept across frames. sf::Text rebuilds its glyph geometry only
+// after its string changes, so the label is re-laid out when the value it
+// shows changes rather than every frame.
+class HudText {
+private:
+    sf::Text text;
+    std::string shown;
+    std::int64_t key;
+    bool hasKey;
+
+public:
+    HudText();
+    void setup(const sf::Font& font, unsigned size, sf::Color color, float x, float y);
+
+    // Calls format() only when key differs from the previous update, so the
+    // string is not even built while the value is unchanged.
+    template<typename Format>
+    void update(std::int64_t key_, Format format) {
+        if(hasKey && key == key_) return;
+        key = key_;
+        hasKey = true;
+        setString(format());
+    }
+    void setString(const std::string& s);
+    void draw(sf::RenderTarget& target) const { target.draw(text); }
+};
+
+// Retained-mode in-game HUD: status line, health bar, mini leaderboard and
+// riddle box. Shapes and labels are built once; each frame only compares the
+// snapshot's values with what is already shown. Render thread only.
+class Hud {
+private:
+    static const int MINI_LEADERBOARD_ROWS = 5;
+
+    float mazeWidth, mazeHeight;
+
+    HudText timeLabel, riddleLabel, visionLabel, ammoLabel;
+
+    sf::RectangleShape healthBg, healthFill;
+    float shownHealth, shownMaxHealth;
+    HudText healthLabel;
+
+    sf::RectangleShape miniBox;
+    HudText miniTitle;
+    HudText miniEntries[MINI_LEADERBOARD_ROWS];
+
+    sf::RectangleShape riddleBox, inputBox;
+    HudText question, reward, answer, hint;
+
+public:
+    Hud(float mazeWidth_, float mazeHeight_);
+    void setFont(const sf::Font& font);
+
+    void drawGameInfo(sf::RenderWindow& window, const FrameSnapshot& frame);
+    void drawHealthBar(sf::RenderWindow& window, const FrameSnapshot& frame);
+    void drawMiniLeaderboard(sf::RenderWindow& window, const FrameSnapshot& frame);
+    void drawRiddleBox(sf::RenderWindow& window, const FrameSnapshot& frame);
+};
+
+#endif
@@ -1,9 +1,10 @@
 #include "Maze.h"
-#include <cstdlib>
+#include "Rng.h"
 
 
-Maze::Maze(int cols_, int rows_, int cellSize_) : cols(cols_), rows(rows_), cellSize(cellSize_), generating(true), startX(0), startY(0), finishX(cols_ - 1), finishY(rows_ - 1) {
-    int cornerChoice = rand() % 3;
+Maze::Maze(int cols_, int rows_, int cellSize_, std::uint64_t seed, const std::string& algorithm) : cols(cols_), rows(rows_), cellSize(cellSize_), grid(cols_, rows_), startX(0), startY(0), finishX(cols_ - 1), finishY(rows_ - 1), generator(nullptr), renderer(nullptr) {
+    Rng rng(seed);
+    int cornerChoice = static_cast<int>(rng.below(3));
     if(cornerChoice == 0) {
  
         finishX = cols_ - 1;
@@ -18,108 +19,76 @@ Maze::Maze(int cols_, int rows_, int cellSize_) : cols(cols_), rows(rows_), cell
         finishY = rows_ - 1;
     }
     
-    grid.resize(rows);
-    for(int y = 0; y < rows; ++y) {
-        grid[y].resize(cols);
-        for(int x = 0; x < cols; ++x) {
-            grid[y][x] = Cell(x, y);
-        }
-    }
-    current = &grid[0][0];
-    current->setVisited(true);
+    std::uint64_t generatorSeed = rng.next();
+    generator = createMazeGenerator(algorithm, grid, generatorSeed);
+    if(!generator) generator = new BacktrackerGenerator(grid, generatorSeed);
 }
 
-Cell* Maze::getCell(int x, int y) {
-    if(x < 0 || x >= cols || y < 0 || y >= rows) return nullptr;
-    return &grid[y][x];
+Maze::~Maze() {
+    delete generator;
+    delete renderer;
 }
 
-Cell* Maze::getUnvisitedNeighbor(Cell* cell) {
-    // Collect unvisited neighbors (top=0, right=1, bottom=2, left=3)
-    std::vector<Cell*> neighbors;
-    std::vector<int> directions;
-    int x = cell->getX();
-    int y = cell->getY();
-    Cell* top = getCell(x, y - 1);
-    Cell* right = getCell(x + 1, y);
-    Cell* bottom = getCell(x, y + 1);
-    Cell* left = getCell(x - 1, y);
-    if(top && !top->isVisited()) { 
-        neighbors.push_back(top); 
-        directions.push_back(0); 
-    }
-    if(right && !right->isVisited()) { 
-        neighbors.push_back(right); 
-        directions.push_back(1); 
-    }
-    if(bottom && !bottom->isVisited()) { 
-        neighbors.push_back(bottom); 
-        directions.push_back(2); 
-    }
-    if(left && !left->isVisited()) { 
-        neighbors.push_back(left); 
-        directions.push_back(3); 
-    }
-    if(neighbors.empty()) return nullptr;
-
+bool Maze::canMove(int x, int y, int dx, int dy) const {
+    return grid.canMove(x, y, dx, dy);
+}
 
-    int idx = rand() % neighbors.size();
-    int dir = directions[idx];
-    current->removeWall(dir);
-    neighbors[idx]->removeWall((dir + 2) % 4); 
-    return neighbors[idx];
+Cell Maze::getCell(size_t index) const {
+    return Cell(grid.cellX(index), grid.cellY(index), grid.bits(index));
 }
 
 void Maze::step() {
-
-    if(!generating) return;
-    Cell* next = getUnvisitedNeighbor(current);
-    if(next) {
-        next->setVisited(true);
-        stack.push(current);
-        current = next;
-    } else if(!stack.empty()) {
-        current = stack.top();
-        stack.pop();
-    } else {
-        generating = false;
-    }
+    if(generator) generator->step();
 }
 
-bool Maze::canMove(int x, int y, int dx, int dy) const {
-    if(x + dx < 0 || x + dx >= cols || y + dy < 0 || y + dy >= rows) return false;
-    const Cell& cell = grid[y][x];
-    if(dx == 0 && dy == -1) return !cell.hasWall(0);
-    if(dx == 1 && dy == 0) return !cell.hasWall(1);
-    if(dx == 0 && dy == 1) return !cell.hasWall(2);
-    if(dx == -1 && dy == 0) return !cell.hasWall(3);
-    return false;
+void Maze::setDirtyList(std::vector<size_t>* dirty) {
+    if(generator) generator->setDirtyList(dirty);
 }
 
-void Maze::draw(sf::RenderWindow& window) {
+void Maze::buildMesh() {
     for(int y = 0; y < rows; ++y) {
         for(int x = 0; x < cols; ++x) {
             bool isStart = (x == startX && y == startY);
             bool isFinish = (x == finishX && y == finishY);
-            grid[y][x].draw(window, cellSize, isStart, isFinish);
+            renderer->updateCell(getCell(grid.index(x, y)), isStart, isFinish);
         }
     }
-    if(generating && current) {
+}
+
+void Maze::flushDirtyCells() {
+    for(size_t index : dirtyCells) {
+        int x = grid.cellX(index);
+        int y = grid.cellY(index);
+        renderer->updateCell(getCell(index), x == startX && y == startY, x == finishX && y == finishY);
+    }
+    dirtyCells.clear();
+}
+
+void Maze::draw(sf::RenderWindow& window) {
+    if(!renderer) {
+        renderer = new MazeRenderer(cols, rows, cellSize);
+        buildMesh();
+        setDirtyList(&dirtyCells);
+    }
+    flushDirtyCells();
+    renderer->draw(window);
+    if(isGenerating()) {
+        size_t current = generator->getCurrent();
         sf::RectangleShape highlight(sf::Vector2f(cellSize - 4, cellSize - 4));
-        highlight.setPosition(current->getX() * cellSize + 2, current->getY() * cellSize + 2);
+        highlight.setPosition(grid.cellX(current) * cellSize + 2, grid.cellY(current) * cellSize + 2);
         highlight.setFillColor(sf::Color(100,200,255));
         window.draw(highlight);
     }
 }
 
-void Maze::drawWithVision(sf::RenderWindow& window, const Player& player) {
+// Immediate per-cell path: one draw call per floor and wall. Kept as the
+// reference for bench/MazeRenderBench.cpp.
+void Maze::drawCells(sf::RenderWindow& window) {
     for(int y = 0; y < rows; ++y) {
         for(int x = 0; x < cols; ++x) {
-            if(player.isInVision(x, y)) {
-                bool isStart = (x == startX && y == startY);
-                bool isFinish = (x == finishX && y == finishY);
-                grid[y][x].draw(window, cellSize, isStart, isFinish);
-            }
+            bool isStart = (x == startX && y == startY);
+            bool isFinish = (x == finishX && y == finishY);
+            getCell(grid.index(x, y)).draw(window, cellSize, isStart, isFinish);
         }
     }
 }
@@ -2,28 +2,37 @@
 #define MAZE_H
 
 #include "Cell.h"
-#include "Player.h"
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "MazeRenderer.h"
+#include <cstdint>
+#include <string>
 #include <vector>
-#include <stack>
 #include <SFML/Graphics.hpp>
 
 class Maze {
 private:
     int cols, rows;
     int cellSize;
-    std::vector<std::vector<Cell>> grid;
-    std::stack<Cell*> stack;
-    Cell* current;
-    bool generating;
+    MazeGrid grid;
     int startX, startY;
     int finishX, finishY;
+    MazeGenerator* generator;
+    // Created by the first draw(); callers that keep their own view of the
+    // cells (see setDirtyList) never pay for the mesh.
+    MazeRenderer* renderer;
+    std::vector<size_t> dirtyCells; // drained by draw()
 
-    Cell* getCell(int x, int y);
-    Cell* getUnvisitedNeighbor(Cell* cell);
+    Cell getCell(size_t index) const;
+    void buildMesh();
+    void flushDirtyCells();
 
 public:
-    Maze(int cols_, int rows_, int cellSize_);
-    ~Maze() {}
+    // The same seed and algorithm always produce the same maze and finish cell.
+    Maze(int cols_, int rows_, int cellSize_, std::uint64_t seed, const std::string& algorithm = "backtracker");
+    ~Maze();
+    Maze(const Maze&) = delete;
+    Maze& operator=(const Maze&) = delete;
 
     int getStartX() const { return startX; }
     int getStartY() const { return startY; }
@@ -31,12 +40,18 @@ public:
     int getFinishY() const { return finishY; }
     int getCols() const { return cols; }
     int getRows() const { return rows; }
+    const MazeGrid& getGrid() const { return grid; }
 
     void step();
-    bool isGenerating() const { return generating; }
+    // Cells changed by later step()s are appended to dirty, which the caller
+    // drains. draw() attaches its own list instead, so use one or the other.
+    void setDirtyList(std::vector<size_t>* dirty);
+    bool isGenerating() const { return generator && generator->isGenerating(); }
+    // Cell the generator is working on; only meaningful while generating.
+    size_t getCurrentCell() const { return generator ? generator->getCurrent() : 0; }
     bool canMove(int x, int y, int dx, int dy) const;
     void draw(sf::RenderWindow& window);
-    void drawWithVision(sf::RenderWindow& window, const Player& player);
+    void drawCells(sf::RenderWindow& window);
 };
 
 #endif
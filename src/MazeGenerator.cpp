@@ -0,0 +1,400 @@
+#include "MazeGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+MazeGenerator::MazeGenerator(MazeGrid& grid_, std::uint64_t seed) : grid(grid_), generating(true), current(0), dirtyCells(nullptr), elapsedSeconds(0), rng(seed) {}
+
+MazeGenerator::~MazeGenerator() {}
+
+void MazeGenerator::markDirty(size_t cell) {
+    if(dirtyCells) dirtyCells->push_back(cell);
+}
+
+void MazeGenerator::carve(size_t cell, int direction) {
+    size_t next = grid.neighbor(cell, direction);
+    grid.removeWall(cell, direction);
+    grid.setVisited(cell);
+    grid.setVisited(next);
+    markDirty(cell);
+    markDirty(next);
+    current = next;
+}
+
+bool MazeGenerator::step() {
+    if(!generating) return false;
+    auto begin = std::chrono::steady_clock::now();
+    generating = advance();
+    elapsedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return generating;
+}
+
+void MazeGenerator::run() {
+    auto begin = std::chrono::steady_clock::now();
+    while(generating) generating = advance();
+    elapsedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+double MazeGenerator::getCellsPerSecond() const {
+    return elapsedSeconds > 0 ? static_cast<double>(grid.size()) / elapsedSeconds : 0;
+}
+
+
+BacktrackerGenerator::BacktrackerGenerator(MazeGrid& grid_, std::uint64_t seed) : BacktrackerGenerator(grid_, seed, 0, 0, grid_.getCols(), grid_.getRows()) {}
+
+BacktrackerGenerator::BacktrackerGenerator(MazeGrid& grid_, std::uint64_t seed, int regionX, int regionY, int regionWidth, int regionHeight)
+    : MazeGenerator(grid_, seed), minX(regionX), minY(regionY), maxX(regionX + regionWidth - 1), maxY(regionY + regionHeight - 1), start(grid_.index(regionX, regionY)) {
+    current = start;
+    grid.setVisited(current);
+}
+
+bool BacktrackerGenerator::advance() {
+    // Collect unvisited neighbors (top=0, right=1, bottom=2, left=3)
+    int directions[4];
+    int count = 0;
+    int x = grid.cellX(current);
+    int y = grid.cellY(current);
+    for(int dir = 0; dir < 4; ++dir) {
+        int nx = x + MazeGrid::DX[dir];
+        int ny = y + MazeGrid::DY[dir];
+        if(nx >= minX && nx <= maxX && ny >= minY && ny <= maxY && !grid.isVisited(grid.index(nx, ny))) directions[count++] = dir;
+    }
+
+    if(count > 0) {
+        // The parent direction stored in the cell replaces the backtracking stack.
+        int dir = directions[rng.below(count)];
+        carve(current, dir);
+        grid.setParent(current, (dir + 2) % 4);
+        return true;
+    }
+    if(current != start) {
+        current = grid.neighbor(current, grid.getParent(current));
+        return true;
+    }
+    return false;
+}
+
+
+WilsonGenerator::WilsonGenerator(MazeGrid& grid_, std::uint64_t seed) : MazeGenerator(grid_, seed), scan(0), walkStart(0), walking(false) {
+    grid.setVisited(0);
+    markDirty(0);
+}
+
+bool WilsonGenerator::advance() {
+    if(!walking) {
+        while(scan < grid.size() && grid.isVisited(scan)) ++scan;
+        if(scan == grid.size()) return false;
+        walkStart = scan;
+        current = scan;
+        walking = true;
+        return true;
+    }
+
+    int directions[4];
+    int count = 0;
+    int x = grid.cellX(current);
+    int y = grid.cellY(current);
+    for(int dir = 0; dir < 4; ++dir) {
+        if(grid.inBounds(x + MazeGrid::DX[dir], y + MazeGrid::DY[dir])) directions[count++] = dir;
+    }
+    int dir = directions[rng.below(count)];
+    grid.setParent(current, dir);
+    size_t next = grid.neighbor(current, dir);
+    if(!grid.isVisited(next)) {
+        current = next;
+        return true;
+    }
+
+    // Hit the maze: following the last exit out of each cell from the walk's
+    // start yields the loop-erased path.
+    size_t cell = walkStart;
+    while(cell != next) {
+        int exit = grid.getParent(cell);
+        size_t following = grid.neighbor(cell, exit);
+        carve(cell, exit);
+        cell = following;
+    }
+    walking = false;
+    return true;
+}
+
+
+EllerRowGenerator::EllerRowGenerator(int cols_, std::uint64_t seed) : cols(cols_), parent(cols_), setSize(cols_), chosen(cols_), used(cols_), rng(seed) {
+    state.labels.resize(cols);
+    state.down.assign(cols, 0);
+    for(int x = 0; x < cols; ++x) state.labels[x] = x;
+}
+
+int EllerRowGenerator::find(int label) {
+    while(parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+void EllerRowGenerator::generateRow(unsigned char* out, bool lastRow) {
+    std::vector<int>& labels = state.labels;
+    std::vector<char>& down = state.down;
+    for(int x = 0; x < cols; ++x) {
+        out[x] = MazeGrid::ALL_WALLS | MazeGrid::VISITED;
+        if(down[x]) out[x] &= static_cast<unsigned char>(~MazeGrid::WALL_TOP);
+        parent[x] = x;
+    }
+
+    // Join neighbours in different sets; the last row must join them all.
+    for(int x = 0; x + 1 < cols; ++x) {
+        int a = find(labels[x]);
+        int b = find(labels[x + 1]);
+        if(a != b && (lastRow || rng.coin())) {
+            out[x] &= static_cast<unsigned char>(~MazeGrid::WALL_RIGHT);
+            out[x + 1] &= static_cast<unsigned char>(~MazeGrid::WALL_LEFT);
+            parent[b] = a;
+        }
+    }
+    for(int x = 0; x < cols; ++x) labels[x] = find(labels[x]);
+    if(lastRow) {
+        std::fill(down.begin(), down.end(), 0);
+        return;
+    }
+
+    // Random downward openings, then force one per set that got none
+    // (chosen holds a reservoir-sampled column of each set).
+    std::fill(setSize.begin(), setSize.end(), 0);
+    std::fill(used.begin(), used.end(), 0);
+    for(int x = 0; x < cols; ++x) {
+        int label = labels[x];
+        down[x] = static_cast<char>(rng.coin());
+        if(down[x]) used[label] = 1;
+        if(rng.below(++setSize[label]) == 0) chosen[label] = x;
+    }
+    for(int x = 0; x < cols; ++x) {
+        int label = labels[x];
+        if(!used[label]) {
+            down[chosen[label]] = 1;
+            used[label] = 1;
+        }
+    }
+    for(int x = 0; x < cols; ++x) {
+        if(down[x]) out[x] &= static_cast<unsigned char>(~MazeGrid::WALL_BOTTOM);
+    }
+
+    // Cells below a downward opening stay in their set; the rest get unused labels.
+    std::fill(used.begin(), used.end(), 0);
+    for(int x = 0; x < cols; ++x) if(down[x]) used[labels[x]] = 1;
+    int freeLabel = 0;
+    for(int x = 0; x < cols; ++x) {
+        if(down[x]) continue;
+        while(used[freeLabel]) ++freeLabel;
+        labels[x] = freeLabel;
+        used[freeLabel] = 1;
+    }
+}
+
+EllerGenerator::EllerGenerator(MazeGrid& grid_, std::uint64_t seed) : MazeGenerator(grid_, seed), rows(grid_.getCols(), seed), row(0) {}
+
+bool EllerGenerator::advance() {
+    rows.generateRow(grid.rowData(row), row == grid.getRows() - 1);
+    for(int x = 0; x < grid.getCols(); ++x) markDirty(grid.index(x, row));
+    current = grid.index(grid.getCols() - 1, row);
+    ++row;
+    return row < grid.getRows();
+}
+
+
+KruskalGenerator::KruskalGenerator(MazeGrid& grid_, std::uint64_t seed) : MazeGenerator(grid_, seed), sets(grid_.size()), nextEdge(0), joined(1) {
+    // Edge e = cell * 2 + (0: wall to the right, 1: wall below).
+    for(int y = 0; y < grid.getRows(); ++y) {
+        for(int x = 0; x < grid.getCols(); ++x) {
+            size_t cell = grid.index(x, y);
+            if(x + 1 < grid.getCols()) edges.push_back(cell * 2);
+            if(y + 1 < grid.getRows()) edges.push_back(cell * 2 + 1);
+        }
+    }
+    for(size_t i = edges.size(); i > 1; --i) std::swap(edges[i - 1], edges[rng.below(i)]);
+    for(size_t i = 0; i < sets.size(); ++i) sets[i] = static_cast<unsigned>(i);
+    grid.setVisited(0);
+}
+
+unsigned KruskalGenerator::find(unsigned cell) {
+    while(sets[cell] != cell) {
+        sets[cell] = sets[sets[cell]];
+        cell = sets[cell];
+    }
+    return cell;
+}
+
+bool KruskalGenerator::advance() {
+    while(nextEdge < edges.size()) {
+        size_t edge = edges[nextEdge++];
+        size_t cell = edge / 2;
+        int dir = (edge % 2) ? 2 : 1;
+        unsigned a = find(static_cast<unsigned>(cell));
+        unsigned b = find(static_cast<unsigned>(grid.neighbor(cell, dir)));
+        if(a == b) continue;
+        sets[b] = a;
+        carve(cell, dir);
+        return ++joined < grid.size();
+    }
+    return false;
+}
+
+
+PrimGenerator::PrimGenerator(MazeGrid& grid_, std::uint64_t seed) : MazeGenerator(grid_, seed) {
+    grid.setVisited(0);
+    markDirty(0);
+    addFrontier(0);
+}
+
+void PrimGenerator::addFrontier(size_t cell) {
+    int x = grid.cellX(cell);
+    int y = grid.cellY(cell);
+    for(int dir = 0; dir < 4; ++dir) {
+        if(!grid.inBounds(x + MazeGrid::DX[dir], y + MazeGrid::DY[dir])) continue;
+        size_t next = grid.neighbor(cell, dir);
+        if(grid.isVisited(next) || grid.isMarked(next)) continue;
+        grid.setMarked(next, true);
+        frontier.push_back(next);
+    }
+}
+
+bool PrimGenerator::advance() {
+    if(frontier.empty()) return false;
+    size_t pick = rng.below(frontier.size());
+    size_t cell = frontier[pick];
+    frontier[pick] = frontier.back();
+    frontier.pop_back();
+    grid.setMarked(cell, false);
+
+    int directions[4];
+    int count = 0;
+    int x = grid.cellX(cell);
+    int y = grid.cellY(cell);
+    for(int dir = 0; dir < 4; ++dir) {
+        int nx = x + MazeGrid::DX[dir];
+        int ny = y + MazeGrid::DY[dir];
+        if(grid.inBounds(nx, ny) && grid.isVisited(grid.index(nx, ny))) directions[count++] = dir;
+    }
+    carve(cell, directions[rng.below(count)]);
+    current = cell;
+    addFrontier(cell);
+    return !frontier.empty();
+}
+
+
+BinaryTreeGenerator::BinaryTreeGenerator(MazeGrid& grid_, std::uint64_t seed) : MazeGenerator(grid_, seed), next(0) {}
+
+bool BinaryTreeGenerator::advance() {
+    size_t cell = next++;
+    int x = grid.cellX(cell);
+    int y = grid.cellY(cell);
+    if(x > 0 && y > 0) carve(cell, rng.coin() ? 0 : 3);
+    else if(y > 0) carve(cell, 0);
+    else if(x > 0) carve(cell, 3);
+    else {
+        grid.setVisited(cell);
+        markDirty(cell);
+    }
+    current = cell;
+    return next < grid.size();
+}
+
+
+ChunkedGenerator::ChunkedGenerator(MazeGrid& grid_, std::uint64_t seed_, int tileSize_, unsigned threadCount_) : MazeGenerator(grid_, seed_), tileSize(std::max(1, tileSize_)), threadCount(threadCount_), seed(seed_) {
+    if(threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ChunkedGenerator::carveTiles() {
+    int tilesX = (grid.getCols() + tileSize - 1) / tileSize;
+    int tilesY = (grid.getRows() + tileSize - 1) / tileSize;
+    int tileCount = tilesX * tilesY;
+    std::atomic<int> nextTile(0);
+
+    // Tiles never share cells, so workers write disjoint bytes of the grid.
+    auto worker = [&]() {
+        for(int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            int x = (tile % tilesX) * tileSize;
+            int y = (tile / tilesX) * tileSize;
+            int width = std::min(tileSize, grid.getCols() - x);
+            int height = std::min(tileSize, grid.getRows() - y);
+            BacktrackerGenerator tileGenerator(grid, Rng::mix(seed, static_cast<std::uint64_t>(tile)), x, y, width, height);
+            tileGenerator.run();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(unsigned i = 1; i < threadCount; ++i) workers.emplace_back(worker);
+    worker();
+    for(std::thread& t : workers) t.join();
+}
+
+void ChunkedGenerator::stitchTiles() {
+    int tilesX = (grid.getCols() + tileSize - 1) / tileSize;
+    int tilesY = (grid.getRows() + tileSize - 1) / tileSize;
+
+    // Edge e = tile * 2 + (0: tile to the right, 1: tile below).
+    std::vector<int> edges;
+    for(int ty = 0; ty < tilesY; ++ty) {
+        for(int tx = 0; tx < tilesX; ++tx) {
+            int tile = ty * tilesX + tx;
+            if(tx + 1 < tilesX) edges.push_back(tile * 2);
+            if(ty + 1 < tilesY) edges.push_back(tile * 2 + 1);
+        }
+    }
+    for(size_t i = edges.size(); i > 1; --i) std::swap(edges[i - 1], edges[rng.below(i)]);
+
+    std::vector<int> sets(tilesX * tilesY);
+    for(size_t i = 0; i < sets.size(); ++i) sets[i] = static_cast<int>(i);
+    auto find = [&](int tile) {
+        while(sets[tile] != tile) {
+            sets[tile] = sets[sets[tile]];
+            tile = sets[tile];
+        }
+        return tile;
+    };
+
+    for(int edge : edges) {
+        int tile = edge / 2;
+        bool below = (edge % 2) != 0;
+        int neighbor = below ? tile + tilesX : tile + 1;
+        int a = find(tile);
+        int b = find(neighbor);
+        if(a == b) continue;
+        sets[b] = a;
+
+        // Open one random wall along the shared border.
+        int tx = (tile % tilesX) * tileSize;
+        int ty = (tile / tilesX) * tileSize;
+        if(below) {
+            int width = std::min(tileSize, grid.getCols() - tx);
+            grid.removeWall(grid.index(tx + static_cast<int>(rng.below(width)), ty + tileSize - 1), 2);
+        } else {
+            int height = std::min(tileSize, grid.getRows() - ty);
+            grid.removeWall(grid.index(tx + tileSize - 1, ty + static_cast<int>(rng.below(height))), 1);
+        }
+    }
+}
+
+bool ChunkedGenerator::advance() {
+    carveTiles();
+    stitchTiles();
+    if(dirtyCells) for(size_t cell = 0; cell < grid.size(); ++cell) markDirty(cell);
+    return false;
+}
+
+
+MazeGenerator* createMazeGenerator(const std::string& name, MazeGrid& grid, std::uint64_t seed) {
+    if(name == "backtracker") return new BacktrackerGenerator(grid, seed);
+    if(name == "wilson") return new WilsonGenerator(grid, seed);
+    if(name == "eller") return new EllerGenerator(grid, seed);
+    if(name == "kruskal") return new KruskalGenerator(grid, seed);
+    if(name == "prim") return new PrimGenerator(grid, seed);
+    if(name == "binary-tree") return new BinaryTreeGenerator(grid, seed);
+    if(name == "chunked") return new ChunkedGenerator(grid, seed);
+    return nullptr;
+}
+
+std::vector<std::string> getMazeGeneratorNames() {
+    return { "backtracker", "wilson", "eller", "kruskal", "prim", "binary-tree", "chunked" };
+}
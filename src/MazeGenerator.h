@@ -0,0 +1,185 @@
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#include "MazeGrid.h"
+#include "Rng.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Base class for maze generation algorithms working on a MazeGrid. step()
+// does one small unit of work so generation can be animated; run() carves
+// the whole maze. No SFML dependency, so generators can run headless.
+class MazeGenerator {
+protected:
+    MazeGrid& grid;
+    bool generating;
+    size_t current;
+    std::vector<size_t>* dirtyCells;
+    double elapsedSeconds;
+    Rng rng;
+
+    // Opens the wall between cell and its neighbour and adds both to the maze.
+    void carve(size_t cell, int direction);
+    void markDirty(size_t cell);
+    virtual bool advance() = 0;
+
+public:
+    MazeGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual ~MazeGenerator();
+
+    virtual const char* getName() const = 0;
+
+    // Cells whose walls change are appended here (e.g. for the renderer).
+    void setDirtyList(std::vector<size_t>* dirty) { dirtyCells = dirty; }
+
+    bool step();
+    void run();
+    bool isGenerating() const { return generating; }
+    size_t getCurrent() const { return current; }
+
+    double getElapsedSeconds() const { return elapsedSeconds; }
+    double getCellsPerSecond() const;
+};
+
+// Depth-first search that backtracks through the parent direction stored in
+// each cell. Long corridors; inherently serial. Can be confined to a
+// rectangular region of the grid, which ChunkedGenerator uses per tile.
+class BacktrackerGenerator : public MazeGenerator {
+private:
+    int minX, minY, maxX, maxY;
+    size_t start;
+protected:
+    virtual bool advance() override;
+public:
+    BacktrackerGenerator(MazeGrid& grid_, std::uint64_t seed);
+    BacktrackerGenerator(MazeGrid& grid_, std::uint64_t seed, int regionX, int regionY, int regionWidth, int regionHeight);
+    virtual const char* getName() const override { return "backtracker"; }
+};
+
+// Uniform spanning tree from loop-erased random walks. The walk direction
+// out of each cell is kept in its parent bits.
+class WilsonGenerator : public MazeGenerator {
+private:
+    size_t scan;
+    size_t walkStart;
+    bool walking;
+protected:
+    virtual bool advance() override;
+public:
+    WilsonGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual const char* getName() const override { return "wilson"; }
+};
+
+// Eller's algorithm for one row at a time. Keeps only O(cols) state (set
+// labels and the previous row's downward openings), so it can stream rows
+// into any buffer, not just a MazeGrid. The state plus the RNG seed fully
+// determine the next row, which lets callers checkpoint and replay rows.
+class EllerRowGenerator {
+public:
+    struct State {
+        std::vector<int> labels;
+        std::vector<char> down;
+    };
+
+private:
+    int cols;
+    State state;
+    std::vector<int> parent;
+    std::vector<int> setSize;
+    std::vector<int> chosen;
+    std::vector<char> used;
+    Rng rng;
+
+    int find(int label);
+
+public:
+    EllerRowGenerator(int cols_, std::uint64_t seed = 0);
+
+    void seed(std::uint64_t seed_) { rng.seed(seed_); }
+    const State& getState() const { return state; }
+    void setState(const State& state_) { state = state_; }
+
+    // Writes one row of cells (wall bits + VISITED) into out[0..cols).
+    void generateRow(unsigned char* out, bool lastRow);
+};
+
+class EllerGenerator : public MazeGenerator {
+private:
+    EllerRowGenerator rows;
+    int row;
+protected:
+    virtual bool advance() override;
+public:
+    EllerGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual const char* getName() const override { return "eller"; }
+};
+
+// Randomized Kruskal: shuffled wall list plus union-find over cells.
+class KruskalGenerator : public MazeGenerator {
+private:
+    std::vector<size_t> edges;
+    std::vector<unsigned> sets;
+    size_t nextEdge;
+    size_t joined;
+
+    unsigned find(unsigned cell);
+protected:
+    virtual bool advance() override;
+public:
+    KruskalGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual const char* getName() const override { return "kruskal"; }
+};
+
+// Randomized Prim: grows the maze from a frontier of adjacent cells.
+class PrimGenerator : public MazeGenerator {
+private:
+    std::vector<size_t> frontier;
+
+    void addFrontier(size_t cell);
+protected:
+    virtual bool advance() override;
+public:
+    PrimGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual const char* getName() const override { return "prim"; }
+};
+
+// Binary tree: every cell opens north or west. Trivially fast and needs no
+// extra state, but biased toward the top-left corner.
+class BinaryTreeGenerator : public MazeGenerator {
+private:
+    size_t next;
+protected:
+    virtual bool advance() override;
+public:
+    BinaryTreeGenerator(MazeGrid& grid_, std::uint64_t seed);
+    virtual const char* getName() const override { return "binary-tree"; }
+};
+
+// Splits the grid into square tiles, carves each tile with a region-bounded
+// backtracker on a pool of worker threads, then joins the tiles with a random
+// spanning tree over the tile graph (one opening per tree edge), so the
+// result is still a perfect maze. Tile seeds derive from the generator seed,
+// so the output does not depend on thread scheduling. Runs in one step().
+class ChunkedGenerator : public MazeGenerator {
+private:
+    int tileSize;
+    unsigned threadCount;
+    std::uint64_t seed;
+
+    void carveTiles();
+    void stitchTiles();
+protected:
+    virtual bool advance() override;
+public:
+    ChunkedGenerator(MazeGrid& grid_, std::uint64_t seed_, int tileSize_ = 256, unsigned threadCount_ = 0);
+    virtual const char* getName() const override { return "chunked"; }
+    unsigned getThreadCount() const { return threadCount; }
+};
+
+// Returns a new generator for the given algorithm name, or nullptr if unknown.
+MazeGenerator* createMazeGenerator(const std::string& name, MazeGrid& grid, std::uint64_t seed);
+std::vector<std::string> getMazeGeneratorNames();
+
+#endif
@@ -0,0 +1,84 @@
+#include "MazeGrid.h"
+#include <cstdint>
+
+const int MazeGrid::DX[4] = { 0, 1, 0, -1 };
+const int MazeGrid::DY[4] = { -1, 0, 1, 0 };
+
+MazeGrid::MazeGrid(int cols_, int rows_) : cols(cols_), rows(rows_), cells(static_cast<size_t>(cols_) * rows_, ALL_WALLS) {}
+
+size_t MazeGrid::neighbor(size_t index, int direction) const {
+    switch(direction) {
+        case 0: return index - cols;
+        case 1: return index + 1;
+        case 2: return index + cols;
+        default: return index - 1;
+    }
+}
+
+void MazeGrid::removeWall(size_t index, int direction) {
+    cells[index] &= static_cast<unsigned char>(~(1 << direction));
+    cells[neighbor(index, direction)] &= static_cast<unsigned char>(~(1 << ((direction + 2) % 4)));
+}
+
+bool MazeGrid::canMove(int x, int y, int dx, int dy) const {
+    // The outer border is never carved, so a wall bit also covers the
+    // "target out of bounds" case once the source cell is in bounds.
+    if(!inBounds(x, y)) return false;
+    int direction;
+    if(dx == 0 && dy == -1) direction = 0;
+    else if(dx == 1 && dy == 0) direction = 1;
+    else if(dx == 0 && dy == 1) direction = 2;
+    else if(dx == -1 && dy == 0) direction = 3;
+    else return false;
+    return (cells[index(x, y)] & (1 << direction)) == 0;
+}
+
+void MazeGrid::reset() {
+    cells.assign(cells.size(), ALL_WALLS);
+}
+
+bool MazeGrid::isPerfect() const {
+    size_t openings = 0;
+    for(int y = 0; y < rows; ++y) {
+        for(int x = 0; x < cols; ++x) {
+            size_t cell = index(x, y);
+            for(int dir = 0; dir < 4; ++dir) {
+                int nx = x + DX[dir];
+                int ny = y + DY[dir];
+                if(!inBounds(nx, ny)) {
+                    if(!hasWall(cell, dir)) return false;
+                } else if(hasWall(cell, dir) != hasWall(neighbor(cell, dir), (dir + 2) % 4)) {
+                    return false;
+                }
+            }
+            if(x + 1 < cols && !hasWall(cell, 1)) ++openings;
+            if(y + 1 < rows && !hasWall(cell, 2)) ++openings;
+        }
+    }
+    // A graph with n nodes and n - 1 edges is a tree iff it is connected.
+    if(openings + 1 != cells.size()) return false;
+
+    // One visited bit per cell and a breadth-first frontier, which in a
+    // maze stays far smaller than the grid: ~n/8 bytes instead of a queue
+    // of every cell.
+    std::vector<std::uint64_t> reached((cells.size() + 63) / 64, 0);
+    std::vector<size_t> frontier(1, 0), next;
+    reached[0] = 1;
+    size_t reachedCount = 1;
+    while(!frontier.empty()) {
+        next.clear();
+        for(size_t cell : frontier) {
+            for(int dir = 0; dir < 4; ++dir) {
+                if(hasWall(cell, dir)) continue;
+                size_t to = neighbor(cell, dir);
+                std::uint64_t bit = std::uint64_t(1) << (to % 64);
+                if(reached[to / 64] & bit) continue;
+                reached[to / 64] |= bit;
+                ++reachedCount;
+                next.push_back(to);
+            }
+        }
+        frontier.swap(next);
+    }
+    return reachedCount == cells.size();
+}
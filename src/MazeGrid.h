@@ -0,0 +1,69 @@
+#ifndef MAZEGRID_H
+#define MAZEGRID_H
+
+#include <vector>
+#include <cstddef>
+
+// Flat, contiguous maze storage with one byte per cell. Coordinates are
+// derived from the index (index = y * cols + x), so a 10k x 10k maze
+// takes ~100 MB. Walls are shared: removeWall clears the bit on both cells.
+class MazeGrid {
+public:
+    // Bit layout of a cell. Directions are 0=top, 1=right, 2=bottom, 3=left.
+    static constexpr unsigned char WALL_TOP = 1 << 0;
+    static constexpr unsigned char WALL_RIGHT = 1 << 1;
+    static constexpr unsigned char WALL_BOTTOM = 1 << 2;
+    static constexpr unsigned char WALL_LEFT = 1 << 3;
+    static constexpr unsigned char ALL_WALLS = 0x0F;
+    static constexpr unsigned char VISITED = 1 << 4;
+    // Direction back to the cell this one was carved from, used by the
+    // backtracker instead of an explicit stack.
+    static constexpr int PARENT_SHIFT = 5;
+    static constexpr unsigned char PARENT_MASK = 3 << PARENT_SHIFT;
+    // Scratch flag for generators (e.g. Prim's frontier membership).
+    static constexpr unsigned char MARKED = 1 << 7;
+
+    static const int DX[4];
+    static const int DY[4];
+
+private:
+    int cols, rows;
+    std::vector<unsigned char> cells;
+
+public:
+    MazeGrid(int cols_, int rows_);
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    size_t size() const { return cells.size(); }
+    size_t memoryBytes() const { return cells.capacity(); }
+
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * cols + x; }
+    int cellX(size_t index) const { return static_cast<int>(index % cols); }
+    int cellY(size_t index) const { return static_cast<int>(index / cols); }
+    bool inBounds(int x, int y) const { return static_cast<unsigned>(x) < static_cast<unsigned>(cols) && static_cast<unsigned>(y) < static_cast<unsigned>(rows); }
+
+    unsigned char bits(size_t index) const { return cells[index]; }
+    bool hasWall(size_t index, int direction) const { return (cells[index] & (1 << direction)) != 0; }
+    bool isVisited(size_t index) const { return (cells[index] & VISITED) != 0; }
+    void setVisited(size_t index) { cells[index] |= VISITED; }
+    int getParent(size_t index) const { return (cells[index] & PARENT_MASK) >> PARENT_SHIFT; }
+    void setParent(size_t index, int direction) { cells[index] = static_cast<unsigned char>((cells[index] & ~PARENT_MASK) | (direction << PARENT_SHIFT)); }
+    bool isMarked(size_t index) const { return (cells[index] & MARKED) != 0; }
+    void setMarked(size_t index, bool marked) { if(marked) cells[index] |= MARKED; else cells[index] &= static_cast<unsigned char>(~MARKED); }
+    // Row-major storage of one row, for generators that emit whole rows.
+    unsigned char* rowData(int y) { return &cells[static_cast<size_t>(y) * cols]; }
+    const unsigned char* rowData(int y) const { return &cells[static_cast<size_t>(y) * cols]; }
+
+    // Neighbour index in the given direction; the caller checks bounds.
+    size_t neighbor(size_t index, int direction) const;
+    void removeWall(size_t index, int direction);
+    bool canMove(int x, int y, int dx, int dy) const;
+    void reset();
+
+    // True when the walls are consistent on both sides, the border is closed
+    // and the open passages form a spanning tree (connected and acyclic).
+    bool isPerfect() const;
+};
+
+#endif
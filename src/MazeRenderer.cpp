@@ -0,0 +1,126 @@
+#include "MazeRenderer.h"
+#include "Cell.h"
+#include <algorithm>
+#include <cmath>
+
+MazeRenderer::MazeRenderer(int cols_, int rows_, int cellSize_) : cols(cols_), rows(rows_), cellSize(cellSize_),
+    mesh(sf::Quads, (static_cast<size_t>(cols_) * rows_ * QUADS_PER_CELL + rows_ + cols_) * 4),
+    buffer(sf::Quads, sf::VertexBuffer::Dynamic), useBuffer(false), visible(sf::Quads) {
+    if(sf::VertexBuffer::isAvailable() && buffer.create(mesh.getVertexCount())) {
+        useBuffer = buffer.update(&mesh[0]);
+    }
+}
+
+size_t MazeRenderer::rightBorderQuad(int y) const {
+    return static_cast<size_t>(cols) * rows * QUADS_PER_CELL + y;
+}
+
+size_t MazeRenderer::bottomBorderQuad(int x) const {
+    return static_cast<size_t>(cols) * rows * QUADS_PER_CELL + rows + x;
+}
+
+void MazeRenderer::setQuad(size_t index, float left, float top, float width, float height, const sf::Color& color) {
+    sf::Vertex* quad = &mesh[index * 4];
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(left + width, top);
+    quad[2].position = sf::Vector2f(left + width, top + height);
+    quad[3].position = sf::Vector2f(left, top + height);
+    for(int i = 0; i < 4; ++i) quad[i].color = color;
+    pendingQuads.push_back(index);
+}
+
+void MazeRenderer::hideQuad(size_t index) {
+    // Collapse the quad to a point so it rasterizes nothing but keeps its slot.
+    sf::Vertex* quad = &mesh[index * 4];
+    for(int i = 0; i < 4; ++i) {
+        quad[i].position = sf::Vector2f(0, 0);
+        quad[i].color = sf::Color::Transparent;
+    }
+    pendingQuads.push_back(index);
+}
+
+void MazeRenderer::updateCell(const Cell& cell, bool isStart, bool isFinish) {
+    int x = cell.getX();
+    int y = cell.getY();
+    size_t base = (static_cast<size_t>(y) * cols + x) * QUADS_PER_CELL;
+    float px = static_cast<float>(x * cellSize);
+    float py = static_cast<float>(y * cellSize);
+    float cs = static_cast<float>(cellSize);
+
+    if(cell.isVisited()) {
+        sf::Color floor(40, 40, 60);
+        if(isStart) floor = sf::Color(50, 150, 50, 180);
+        else if(isFinish) floor = sf::Color(150, 50, 50, 180);
+        setQuad(base, px, py, cs, cs, floor);
+    } else {
+        hideQuad(base);
+    }
+
+    // Same wall geometry as Cell::draw.
+    sf::Color wallColor(200, 200, 220);
+    if(cell.hasWall(0)) setQuad(base + 1, px, py, cs, 2, wallColor); else hideQuad(base + 1);
+    if(cell.hasWall(3)) setQuad(base + 2, px, py, 2, cs, wallColor); else hideQuad(base + 2);
+    if(x == cols - 1) {
+        if(cell.hasWall(1)) setQuad(rightBorderQuad(y), px + cs, py, 2, cs, wallColor); else hideQuad(rightBorderQuad(y));
+    }
+    if(y == rows - 1) {
+        if(cell.hasWall(2)) setQuad(bottomBorderQuad(x), px, py + cs, cs, 2, wallColor); else hideQuad(bottomBorderQuad(x));
+    }
+}
+
+void MazeRenderer::upload() {
+    if(useBuffer && !pendingQuads.empty()) {
+        // A full rebuild is cheaper as one upload than as many small patches.
+        if(pendingQuads.size() * 4 * 8 >= mesh.getVertexCount()) buffer.update(&mesh[0]);
+        else for(size_t quad : pendingQuads) buffer.update(&mesh[quad * 4], 4, static_cast<unsigned>(quad * 4));
+    }
+    pendingQuads.clear();
+}
+
+void MazeRenderer::draw(sf::RenderTarget& target) {
+    upload();
+    if(useBuffer) target.draw(buffer);
+    else target.draw(mesh);
+}
+
+void MazeRenderer::drawRange(sf::RenderTarget& target, int minX, int minY, int maxX, int maxY) {
+    minX = std::max(0, minX);
+    maxX = std::min(cols - 1, maxX);
+    minY = std::max(0, minY);
+    maxY = std::min(rows - 1, maxY);
+    if(minX > maxX || minY > maxY) return;
+
+    upload();
+    visible.clear();
+    for(int y = minY; y <= maxY; ++y) {
+        size_t first = (static_cast<size_t>(y) * cols + minX) * VERTS_PER_CELL;
+        size_t last = (static_cast<size_t>(y) * cols + maxX + 1) * VERTS_PER_CELL;
+        for(size_t i = first; i < last; ++i) visible.append(mesh[i]);
+        if(maxX == cols - 1) for(int i = 0; i < 4; ++i) visible.append(mesh[rightBorderQuad(y) * 4 + i]);
+        if(y == rows - 1) {
+            for(int x = minX; x <= maxX; ++x) for(int i = 0; i < 4; ++i) visible.append(mesh[bottomBorderQuad(x) * 4 + i]);
+        }
+    }
+    target.draw(visible);
+}
+
+void MazeRenderer::appendQuad(size_t index) {
+    for(int i = 0; i < 4; ++i) visible.append(mesh[index * 4 + i]);
+}
+
+void MazeRenderer::drawCells(sf::RenderTarget& target, const std::vector<size_t>& cells) {
+    // Copy the slots of the listed cells into one batch. A cell's right and
+    // bottom walls live in its neighbours' slots, which are usually not
+    // listed, so they are copied too.
+    upload();
+    visible.clear();
+    for(size_t cell : cells) {
+        int x = static_cast<int>(cell % cols);
+        int y = static_cast<int>(cell / cols);
+        size_t base = (static_cast<size_t>(y) * cols + x) * QUADS_PER_CELL;
+        for(int q = 0; q < QUADS_PER_CELL; ++q) appendQuad(base + q);
+        appendQuad(x == cols - 1 ? rightBorderQuad(y) : base + QUADS_PER_CELL + 2);
+        appendQuad(y == rows - 1 ? bottomBorderQuad(x) : base + static_cast<size_t>(cols) * QUADS_PER_CELL + 1);
+    }
+    target.draw(visible);
+}
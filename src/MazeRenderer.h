@@ -0,0 +1,49 @@
+#ifndef MAZERENDERER_H
+#define MAZERENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class Cell;
+
+// Batched maze mesh. Every cell owns a fixed slot of three quads (floor,
+// top wall, left wall); right and bottom walls are the neighbours' left and
+// top walls, plus one border quad per row and column along the far edges.
+// The mesh lives in a persistent vertex buffer and only slots passed to
+// updateCell are re-uploaded, so a generation step costs the cells it
+// touched rather than the size of the grid.
+class MazeRenderer {
+private:
+    static const int QUADS_PER_CELL = 3;
+    static const int VERTS_PER_CELL = QUADS_PER_CELL * 4;
+
+    int cols, rows;
+    int cellSize;
+    sf::VertexArray mesh;
+    sf::VertexBuffer buffer;
+    bool useBuffer;
+    std::vector<size_t> pendingQuads;
+    sf::VertexArray visible;
+
+    size_t rightBorderQuad(int y) const;
+    size_t bottomBorderQuad(int x) const;
+    void setQuad(size_t index, float left, float top, float width, float height, const sf::Color& color);
+    void hideQuad(size_t index);
+    void appendQuad(size_t index); // to visible
+    void upload();
+
+public:
+    MazeRenderer(int cols_, int rows_, int cellSize_);
+
+    void updateCell(const Cell& cell, bool isStart, bool isFinish);
+
+    void draw(sf::RenderTarget& target);
+    // Cells in columns minX..maxX and rows minY..maxY (clamped), e.g. those
+    // under the camera; costs the range, not the grid.
+    void drawRange(sf::RenderTarget& target, int minX, int minY, int maxX, int maxY);
+    // Only the given cells (index y * cols + x), e.g. those in line of sight,
+    // with all four of their walls.
+    void drawCells(sf::RenderTarget& target, const std::vector<size_t>& cells);
+};
+
+#endif
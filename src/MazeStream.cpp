@@ -0,0 +1,66 @@
+#include "MazeStream.h"
+#include <algorithm>
+
+MazeStream::MazeStream(MazeGrid& ring_, std::uint64_t seed_, int checkpointInterval_, int maxCheckpoints_) : ring(ring_), cols(ring_.getCols()), windowRows(ring_.getRows()),
+    seed(seed_), checkpointInterval(std::max(1, checkpointInterval_)), maxCheckpoints(std::max(2, maxCheckpoints_)), rows(ring_.getCols()), generatorRow(0), firstRow(0), scratch(ring_.getCols()) {
+    checkpoints.push_back(rows.getState());
+    produceRows(0, windowRows - 1);
+}
+
+// Called with the generator at row checkpoints.size() * checkpointInterval.
+void MazeStream::addCheckpoint() {
+    checkpoints.push_back(rows.getState());
+    if(static_cast<int>(checkpoints.size()) <= maxCheckpoints) return;
+    // Keep the even checkpoints: old k = 2j sits at row j * (2 * interval).
+    size_t kept = 0;
+    for(size_t k = 0; k < checkpoints.size(); k += 2) std::swap(checkpoints[kept++], checkpoints[k]);
+    checkpoints.resize(kept);
+    checkpointInterval *= 2;
+}
+
+void MazeStream::produceRows(std::int64_t from, std::int64_t to) {
+    // Resume from the generator's current row when it is not past 'from' and
+    // no later checkpoint is closer; otherwise replay from a checkpoint.
+    std::int64_t checkpoint = std::min<std::int64_t>(from / checkpointInterval, static_cast<std::int64_t>(checkpoints.size()) - 1);
+    if(generatorRow > from || checkpoint * checkpointInterval > generatorRow) {
+        rows.setState(checkpoints[checkpoint]);
+        generatorRow = checkpoint * checkpointInterval;
+    }
+
+    for(; generatorRow <= to; ++generatorRow) {
+        if(generatorRow % checkpointInterval == 0 && generatorRow / checkpointInterval == static_cast<std::int64_t>(checkpoints.size())) addCheckpoint();
+        rows.seed(Rng::mix(seed, static_cast<std::uint64_t>(generatorRow)));
+        bool resident = generatorRow >= from;
+        rows.generateRow(resident ? ring.rowData(static_cast<int>(generatorRow % windowRows)) : scratch.data(), false);
+    }
+}
+
+void MazeStream::setWindow(std::int64_t first) {
+    first = std::max<std::int64_t>(0, first);
+    if(first == firstRow) return;
+    std::int64_t last = first + windowRows - 1;
+    std::int64_t oldFirst = firstRow;
+    std::int64_t oldLast = getLastRow();
+    firstRow = first;
+
+    // Rows in both windows keep their ring slots; only the rest is produced.
+    if(first > oldLast || last < oldFirst) produceRows(first, last);
+    else if(first > oldFirst) produceRows(oldLast + 1, last);
+    else produceRows(first, oldFirst - 1);
+}
+
+bool MazeStream::canMove(int x, std::int64_t y, int dx, int dy) const {
+    if(!isResident(y) || !isResident(y + dy)) return false;
+    if(x < 0 || x >= cols) return false;
+    int direction;
+    if(dx == 0 && dy == -1) direction = 0;
+    else if(dx == 1 && dy == 0) direction = 1;
+    else if(dx == 0 && dy == 1) direction = 2;
+    else if(dx == -1 && dy == 0) direction = 3;
+    else return false;
+    return !ring.hasWall(index(x, y), direction);
+}
+
+size_t MazeStream::checkpointBytes() const {
+    return checkpoints.size() * static_cast<size_t>(cols) * (sizeof(int) + sizeof(char));
+}
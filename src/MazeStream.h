@@ -0,0 +1,51 @@
+#ifndef MAZESTREAM_H
+#define MAZESTREAM_H
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include <cstdint>
+#include <vector>
+
+// Endless maze produced lazily, row by row, with Eller's algorithm. Only a
+// sliding window of rows is resident: absolute row y lives in row
+// y % windowRows of the ring grid, and rows that scroll out are simply
+// overwritten. Every row is seeded from (seed, row) and the generator state
+// is checkpointed every checkpointInterval rows, so an evicted row can be
+// regenerated exactly by replaying from the nearest checkpoint. At most
+// maxCheckpoints are kept: when the list is full every other one is dropped
+// and the interval doubles, so memory stays bounded however far the stream
+// runs, at the cost of longer replays. No SFML dependency.
+class MazeStream {
+private:
+    MazeGrid& ring;
+    int cols, windowRows;
+    std::uint64_t seed;
+    std::int64_t checkpointInterval;
+    int maxCheckpoints;
+    EllerRowGenerator rows;
+    std::int64_t generatorRow;
+    std::int64_t firstRow;
+    std::vector<EllerRowGenerator::State> checkpoints; // row k * checkpointInterval
+    std::vector<unsigned char> scratch;
+
+    void produceRows(std::int64_t from, std::int64_t to);
+    void addCheckpoint();
+
+public:
+    MazeStream(MazeGrid& ring_, std::uint64_t seed_, int checkpointInterval_ = 64, int maxCheckpoints_ = 256);
+
+    // Makes rows [first, first + windowRows) resident.
+    void setWindow(std::int64_t first);
+    std::int64_t getFirstRow() const { return firstRow; }
+    std::int64_t getLastRow() const { return firstRow + windowRows - 1; }
+    bool isResident(std::int64_t y) const { return y >= firstRow && y <= getLastRow(); }
+
+    size_t index(int x, std::int64_t y) const { return ring.index(x, static_cast<int>(y % windowRows)); }
+    unsigned char bits(int x, std::int64_t y) const { return ring.bits(index(x, y)); }
+    bool canMove(int x, std::int64_t y, int dx, int dy) const;
+
+    std::int64_t getCheckpointInterval() const { return checkpointInterval; }
+    size_t checkpointBytes() const;
+};
+
+#endif
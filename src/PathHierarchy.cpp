@@ -0,0 +1,341 @@
+#include "PathHierarchy.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+PathHierarchy::PathHierarchy(int cols_, int rows_, int clusterSize_)
+    : cols(cols_), rows(rows_), clusterSize(clusterSize_),
+      clustersX((cols_ + clusterSize_ - 1) / clusterSize_), clustersY((rows_ + clusterSize_ - 1) / clusterSize_),
+      maxNodes(4 * clusterSize_), clusters(static_cast<size_t>(clustersX) * clustersY) {
+    for(Cluster& cluster : clusters) cluster.dirty = false;
+    // One more id past the last node stands for the goal.
+    size_t ids = clusters.size() * maxNodes + 1;
+    cost.assign(ids, -1);
+    parent.assign(ids, -1);
+    closed.assign(ids, 0);
+}
+
+int PathHierarchy::nodeIndex(const Cluster& cluster, size_t cell) const {
+    auto it = std::lower_bound(cluster.nodes.begin(), cluster.nodes.end(), cell);
+    if(it == cluster.nodes.end() || *it != cell) return -1;
+    return static_cast<int>(it - cluster.nodes.begin());
+}
+
+void PathHierarchy::build(const MazeGrid& grid) {
+    for(int id = 0; id < static_cast<int>(clusters.size()); ++id) {
+        if(clusters[id].dirty) continue;
+        clusters[id].dirty = true;
+        dirtyClusters.push_back(id);
+    }
+    update(grid);
+}
+
+// Walls are shared with the neighbouring cells, which may sit in other
+// clusters.
+void PathHierarchy::invalidate(int x, int y) {
+    for(int dir = -1; dir < 4; ++dir) {
+        int nx = dir < 0 ? x : x + MazeGrid::DX[dir];
+        int ny = dir < 0 ? y : y + MazeGrid::DY[dir];
+        if(nx < 0 || nx >= cols || ny < 0 || ny >= rows) continue;
+        int id = clusterOf(nx, ny);
+        if(clusters[id].dirty) continue;
+        clusters[id].dirty = true;
+        dirtyClusters.push_back(id);
+    }
+}
+
+int PathHierarchy::update(const MazeGrid& grid) {
+    int rebuilt = static_cast<int>(dirtyClusters.size());
+    for(int id : dirtyClusters) {
+        rebuildCluster(grid, id);
+        clusters[id].dirty = false;
+    }
+    dirtyClusters.clear();
+    return rebuilt;
+}
+
+void PathHierarchy::rebuildCluster(const MazeGrid& grid, int id) {
+    Cluster& cluster = clusters[id];
+    int x0 = id % clustersX * clusterSize;
+    int y0 = id / clustersX * clusterSize;
+    int x1 = std::min(cols, x0 + clusterSize);
+    int y1 = std::min(rows, y0 + clusterSize);
+
+    // Row-major order keeps the nodes ascending by cell index.
+    cluster.nodes.clear();
+    for(int y = y0; y < y1; ++y) {
+        for(int x = x0; x < x1; ++x) {
+            if(x != x0 && x != x1 - 1 && y != y0 && y != y1 - 1) continue;
+            size_t cell = grid.index(x, y);
+            for(int dir = 0; dir < 4; ++dir) {
+                int nx = x + MazeGrid::DX[dir];
+                int ny = y + MazeGrid::DY[dir];
+                if(grid.hasWall(cell, dir) || !grid.inBounds(nx, ny) || clusterOf(nx, ny) == id) continue;
+                cluster.nodes.push_back(cell);
+                break;
+            }
+        }
+    }
+
+    size_t count = cluster.nodes.size();
+    cluster.firstEdge.assign(1, 0);
+    cluster.edges.clear();
+    for(size_t i = 0; i < count; ++i) {
+        searchCluster(grid, cluster.nodes[i], local, queue);
+        for(size_t j = 0; j < count; ++j) {
+            int length = local[localIndex(cluster.nodes[j])];
+            if(j != i && length > 0) cluster.edges.push_back(Edge{static_cast<int>(j), length});
+        }
+        cluster.firstEdge.push_back(static_cast<int>(cluster.edges.size()));
+    }
+}
+
+void PathHierarchy::searchCluster(const MazeGrid& grid, size_t from, std::vector<int>& distances, std::vector<int>& queue) const {
+    int id = clusterOf(from);
+    int x0 = id % clustersX * clusterSize;
+    int y0 = id / clustersX * clusterSize;
+    int x1 = std::min(cols, x0 + clusterSize);
+    int y1 = std::min(rows, y0 + clusterSize);
+
+    distances.assign(static_cast<size_t>(clusterSize) * clusterSize, -1);
+    queue.clear();
+    distances[localIndex(from)] = 0;
+    queue.push_back(localIndex(from));
+    for(size_t head = 0; head < queue.size(); ++head) {
+        int x = x0 + queue[head] % clusterSize;
+        int y = y0 + queue[head] / clusterSize;
+        size_t cell = grid.index(x, y);
+        int distance = distances[queue[head]];
+        for(int dir = 0; dir < 4; ++dir) {
+            int nx = x + MazeGrid::DX[dir];
+            int ny = y + MazeGrid::DY[dir];
+            if(grid.hasWall(cell, dir) || nx < x0 || nx >= x1 || ny < y0 || ny >= y1) continue;
+            int next = (ny - y0) * clusterSize + (nx - x0);
+            if(distances[next] >= 0) continue;
+            distances[next] = distance + 1;
+            queue.push_back(next);
+        }
+    }
+}
+
+template<class Link>
+void PathHierarchy::forEachLink(const MazeGrid& grid, int id, Link link) const {
+    int clusterId = id / maxNodes;
+    int node = id % maxNodes;
+    const Cluster& cluster = clusters[clusterId];
+    size_t cell = cluster.nodes[node];
+    for(int e = cluster.firstEdge[node]; e < cluster.firstEdge[node + 1]; ++e) {
+        link(clusterId * maxNodes + cluster.edges[e].to, cluster.edges[e].length);
+    }
+    for(int dir = 0; dir < 4; ++dir) {
+        int nx = grid.cellX(cell) + MazeGrid::DX[dir];
+        int ny = grid.cellY(cell) + MazeGrid::DY[dir];
+        if(grid.hasWall(cell, dir) || !grid.inBounds(nx, ny)) continue;
+        int neighbourCluster = clusterOf(nx, ny);
+        if(neighbourCluster == clusterId) continue;
+        int index = nodeIndex(clusters[neighbourCluster], grid.index(nx, ny));
+        if(index >= 0) link(neighbourCluster * maxNodes + index, 1);
+    }
+}
+
+// A* over entrance nodes. The start links to the nodes of its cluster and
+// the goal's cluster nodes link to the goal, both by in-cluster searches; a
+// start and goal in one cluster are also linked directly. Edge costs are real
+// path lengths, so the Manhattan distance to the goal is a consistent
+// heuristic.
+int PathHierarchy::findRoute(const MazeGrid& grid, int startX, int startY, int goalX, int goalY, std::vector<size_t>& waypoints) {
+    waypoints.clear();
+    if(!grid.inBounds(startX, startY) || !grid.inBounds(goalX, goalY)) return -1;
+    size_t start = grid.index(startX, startY);
+    size_t goal = grid.index(goalX, goalY);
+    if(start == goal) return 0;
+    int startCluster = clusterOf(start);
+    int goalCluster = clusterOf(goal);
+    searchCluster(grid, start, fromStart, queue);
+    searchCluster(grid, goal, fromGoal, queue);
+
+    const int goalId = static_cast<int>(clusters.size()) * maxNodes;
+    for(int id : touched) {
+        cost[id] = parent[id] = -1;
+        closed[id] = 0;
+    }
+    touched.clear();
+    open.clear();
+    auto relax = [&](int id, size_t cell, int newCost, int from) {
+        if(closed[id] || (cost[id] >= 0 && cost[id] <= newCost)) return;
+        if(cost[id] < 0) touched.push_back(id);
+        cost[id] = newCost;
+        parent[id] = from;
+        int estimate = newCost;
+        if(id != goalId) estimate += std::abs(static_cast<int>(cell % cols) - goalX) + std::abs(static_cast<int>(cell / cols) - goalY);
+        open.push_back(std::make_pair(estimate, id));
+        std::push_heap(open.begin(), open.end(), std::greater<std::pair<int, int> >());
+    };
+
+    const Cluster& first = clusters[startCluster];
+    for(size_t i = 0; i < first.nodes.size(); ++i) {
+        int distance = fromStart[localIndex(first.nodes[i])];
+        if(distance >= 0) relax(startCluster * maxNodes + static_cast<int>(i), first.nodes[i], distance, -1);
+    }
+    if(startCluster == goalCluster && fromStart[localIndex(goal)] >= 0) relax(goalId, goal, fromStart[localIndex(goal)], -1);
+
+    while(!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<std::pair<int, int> >());
+        int id = open.back().second;
+        open.pop_back();
+        if(closed[id]) continue;
+        closed[id] = 1;
+        if(id == goalId) break;
+
+        forEachLink(grid, id, [&](int other, int length) { relax(other, nodeCell(other), cost[id] + length, id); });
+        size_t cell = nodeCell(id);
+        if(id / maxNodes == goalCluster && fromGoal[localIndex(cell)] >= 0) relax(goalId, goal, cost[id] + fromGoal[localIndex(cell)], id);
+    }
+
+    if(!closed[goalId]) return -1;
+    for(int id = parent[goalId]; id >= 0; id = parent[id]) {
+        size_t cell = nodeCell(id);
+        if(cell != start && cell != goal) waypoints.push_back(cell);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    waypoints.push_back(goal);
+    return cost[goalId];
+}
+
+// Dijkstra from the goal: the goal's cluster nodes start at their in-cluster
+// distance to it, and next[] points back toward the goal. Routes are
+// undirected, so these are also the costs from each node to the goal.
+void PathHierarchy::solveGoalField(const MazeGrid& grid, size_t goal, const size_t* starts, size_t startCount, GoalField& field) const {
+    size_t ids = clusters.size() * maxNodes;
+    if(field.cost.size() != ids) {
+        field.cost.assign(ids, -1);
+        field.next.assign(ids, -1);
+        field.closed.assign(ids, 0);
+        field.touched.clear();
+    }
+    for(int id : field.touched) {
+        field.cost[id] = field.next[id] = -1;
+        field.closed[id] = 0;
+    }
+    field.touched.clear();
+    field.open.clear();
+    field.startCluster.assign(clusters.size(), 0);
+    field.startClusters.clear();
+    field.goal = goal;
+
+    // Nodes of the starts' clusters still to settle.
+    int remaining = 0;
+    for(size_t i = 0; i < startCount; ++i) {
+        int id = clusterOf(starts[i]);
+        if(field.startCluster[id]) continue;
+        field.startCluster[id] = 1;
+        field.startClusters.push_back(id);
+        remaining += static_cast<int>(clusters[id].nodes.size());
+    }
+
+    auto relax = [&](int id, int newCost, int from) {
+        if(field.closed[id] || (field.cost[id] >= 0 && field.cost[id] <= newCost)) return;
+        if(field.cost[id] < 0) field.touched.push_back(id);
+        field.cost[id] = newCost;
+        field.next[id] = from;
+        field.open.push_back(std::make_pair(newCost, id));
+        std::push_heap(field.open.begin(), field.open.end(), std::greater<std::pair<int, int> >());
+    };
+
+    int goalCluster = clusterOf(goal);
+    searchCluster(grid, goal, field.fromGoal, field.queue);
+    const Cluster& last = clusters[goalCluster];
+    for(size_t i = 0; i < last.nodes.size(); ++i) {
+        int distance = field.fromGoal[localIndex(last.nodes[i])];
+        if(distance >= 0) relax(goalCluster * maxNodes + static_cast<int>(i), distance, -1);
+    }
+
+    while(!field.open.empty() && remaining > 0) {
+        std::pop_heap(field.open.begin(), field.open.end(), std::greater<std::pair<int, int> >());
+        int id = field.open.back().second;
+        field.open.pop_back();
+        if(field.closed[id]) continue;
+        field.closed[id] = 1;
+        if(field.startCluster[id / maxNodes]) --remaining;
+        forEachLink(grid, id, [&](int other, int length) { relax(other, field.cost[id] + length, id); });
+    }
+}
+
+int PathHierarchy::routeFrom(const MazeGrid& grid, size_t start, const GoalField& field, Scratch& scratch, size_t& waypoint) const {
+    waypoint = field.goal;
+    if(start == field.goal) return 0;
+    int startCluster = clusterOf(start);
+    if(field.startCluster.empty() || !field.startCluster[startCluster]) return -1;
+    searchCluster(grid, start, scratch.distances, scratch.queue);
+
+    int best = -1;
+    int bestNode = -1;
+    if(startCluster == clusterOf(field.goal)) best = scratch.distances[localIndex(field.goal)];
+    const Cluster& first = clusters[startCluster];
+    for(size_t i = 0; i < first.nodes.size(); ++i) {
+        int id = startCluster * maxNodes + static_cast<int>(i);
+        int distance = scratch.distances[localIndex(first.nodes[i])];
+        if(distance < 0 || !field.closed[id]) continue;
+        if(best < 0 || distance + field.cost[id] < best) {
+            best = distance + field.cost[id];
+            bestNode = id;
+        }
+    }
+    if(bestNode >= 0) {
+        // A start standing on an entrance skips past it, as findRoute does.
+        int id = nodeCell(bestNode) == start ? field.next[bestNode] : bestNode;
+        if(id >= 0) waypoint = nodeCell(id);
+    }
+    return best;
+}
+
+int PathHierarchy::firstStep(const MazeGrid& grid, size_t from, size_t to) {
+    int x = grid.cellX(from);
+    int y = grid.cellY(from);
+    for(int dir = 0; dir < 4; ++dir) {
+        if(!grid.hasWall(from, dir) && grid.inBounds(x + MazeGrid::DX[dir], y + MazeGrid::DY[dir]) && grid.neighbor(from, dir) == to) return dir;
+    }
+    int id = clusterOf(from);
+    if(clusterOf(to) != id) return -1;
+    searchCluster(grid, to, local, queue);
+    int distance = local[localIndex(from)];
+    if(distance <= 0) return -1;
+    for(int dir = 0; dir < 4; ++dir) {
+        int nx = x + MazeGrid::DX[dir];
+        int ny = y + MazeGrid::DY[dir];
+        if(grid.hasWall(from, dir) || !grid.inBounds(nx, ny) || clusterOf(nx, ny) != id) continue;
+        if(local[localIndex(grid.index(nx, ny))] == distance - 1) return dir;
+    }
+    return -1;
+}
+
+bool PathHierarchy::refine(const MazeGrid& grid, size_t from, const std::vector<size_t>& waypoints, std::vector<size_t>& cells) {
+    size_t cell = from;
+    for(size_t waypoint : waypoints) {
+        // One in-cluster search per segment; each step then picks the
+        // neighbour one closer to the waypoint.
+        if(clusterOf(waypoint) == clusterOf(cell)) searchCluster(grid, waypoint, local, queue);
+        while(cell != waypoint) {
+            int dir = -1;
+            for(int d = 0; d < 4 && dir < 0; ++d) {
+                int nx = grid.cellX(cell) + MazeGrid::DX[d];
+                int ny = grid.cellY(cell) + MazeGrid::DY[d];
+                if(grid.hasWall(cell, d) || !grid.inBounds(nx, ny)) continue;
+                size_t next = grid.index(nx, ny);
+                if(next == waypoint) dir = d;
+                else if(clusterOf(next) == clusterOf(cell) && clusterOf(waypoint) == clusterOf(cell) &&
+                        local[localIndex(next)] >= 0 && local[localIndex(next)] == local[localIndex(cell)] - 1) dir = d;
+            }
+            if(dir < 0) return false;
+            cell = grid.neighbor(cell, dir);
+            cells.push_back(cell);
+        }
+    }
+    return true;
+}
+
+size_t PathHierarchy::getNodeCount() const {
+    size_t count = 0;
+    for(const Cluster& cluster : clusters) count += cluster.nodes.size();
+    return count;
+}
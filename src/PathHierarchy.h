@@ -0,0 +1,129 @@
+#ifndef PATHHIERARCHY_H
+#define PATHHIERARCHY_H
+
+#include "MazeGrid.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Hierarchical pathfinding (HPA*) over a MazeGrid. The grid is cut into
+// square clusters; every cell with an open passage across its cluster's edge
+// is an entrance node, and each cluster stores the shortest in-cluster path
+// length between each pair of its nodes that are connected inside it. A long
+// route is then an A* search over entrance nodes (a few per cluster crossed)
+// plus one in-cluster search at each end, and is refined into cells one
+// cluster at a time as it is walked. Every crossing is its own node, so
+// routes are as short as a flat search would find. A cluster depends only on
+// its own cells, so wall changes rebuild just the clusters they touch.
+// No SFML dependency.
+class PathHierarchy {
+public:
+    static const int DEFAULT_CLUSTER_SIZE = 32;
+
+    // Scratch for routeFrom(); one per thread.
+    struct Scratch {
+        std::vector<int> distances, queue;
+    };
+
+    // Costs from entrance nodes to one goal cell, filled by solveGoalField()
+    // and shared by every route to that goal. Its arrays are reused and
+    // reset lazily between goals; one per thread.
+    struct GoalField {
+        size_t goal;
+        std::vector<int> cost, next; // by node id; next is the node one step closer
+        std::vector<unsigned char> closed;
+        std::vector<int> touched;
+        std::vector<std::pair<int, int> > open;
+        std::vector<int> fromGoal, queue;
+        std::vector<unsigned char> startCluster; // by cluster
+        std::vector<int> startClusters;
+    };
+
+private:
+    struct Edge {
+        int to;     // node index in the same cluster
+        int length; // in-cluster path length
+    };
+
+    struct Cluster {
+        std::vector<size_t> nodes;    // entrance cells, ascending
+        // Edges of node i are edges[firstEdge[i]] .. edges[firstEdge[i + 1]];
+        // only node pairs connected inside the cluster have one.
+        std::vector<int> firstEdge;
+        std::vector<Edge> edges;
+        bool dirty;
+    };
+
+    int cols, rows, clusterSize;
+    int clustersX, clustersY;
+    // Node ids for the search are cluster * maxNodes + index in the cluster;
+    // a cluster has at most one entrance per edge cell and side.
+    int maxNodes;
+    std::vector<Cluster> clusters;
+    std::vector<int> dirtyClusters;
+
+    // Scratch for in-cluster breadth-first searches (clusterSize^2 cells) and
+    // for the abstract search, reset lazily; queries are not thread-safe.
+    std::vector<int> fromStart, fromGoal, local;
+    std::vector<int> queue;
+    std::vector<int> cost, parent;
+    std::vector<unsigned char> closed;
+    std::vector<int> touched;
+    std::vector<std::pair<int, int> > open;
+
+    int clusterOf(int x, int y) const { return (y / clusterSize) * clustersX + x / clusterSize; }
+    int clusterOf(size_t cell) const { return clusterOf(static_cast<int>(cell % cols), static_cast<int>(cell / cols)); }
+    int localIndex(size_t cell) const { return static_cast<int>(cell / cols) % clusterSize * clusterSize + static_cast<int>(cell % cols) % clusterSize; }
+    int nodeIndex(const Cluster& cluster, size_t cell) const;
+    size_t nodeCell(int id) const { return clusters[id / maxNodes].nodes[id % maxNodes]; }
+    void rebuildCluster(const MazeGrid& grid, int id);
+    // Path lengths inside from's cluster from 'from' to every cell of it
+    // (by localIndex), -1 where unreachable without leaving the cluster.
+    void searchCluster(const MazeGrid& grid, size_t from, std::vector<int>& distances, std::vector<int>& queue) const;
+    // Calls link(otherId, length) for each node joined to node id by an
+    // in-cluster edge or a passage into the neighbouring cluster.
+    template<class Link>
+    void forEachLink(const MazeGrid& grid, int id, Link link) const;
+
+public:
+    PathHierarchy(int cols_, int rows_, int clusterSize_ = DEFAULT_CLUSTER_SIZE);
+
+    // Builds every cluster.
+    void build(const MazeGrid& grid);
+    // Marks the clusters a wall change at cell (x, y) can affect; update()
+    // rebuilds them.
+    void invalidate(int x, int y);
+    // Rebuilds invalidated clusters and returns how many there were.
+    int update(const MazeGrid& grid);
+
+    // Shortest route from (startX, startY) to (goalX, goalY): fills waypoints
+    // with the entrance cells passed, then the goal, and returns the length in
+    // steps, or -1 if there is no route. Consecutive waypoints are either in
+    // one cluster or neighbours across a cluster edge.
+    int findRoute(const MazeGrid& grid, int startX, int startY, int goalX, int goalY, std::vector<size_t>& waypoints);
+    // Direction (0=top, 1=right, 2=bottom, 3=left) of the first step from
+    // 'from' toward the next waypoint 'to', or -1 if 'to' is neither an open
+    // neighbour nor reachable inside from's cluster.
+    int firstStep(const MazeGrid& grid, size_t from, size_t to);
+    // Appends the cells after 'from' along the route through waypoints.
+    // Returns false if a segment cannot be walked.
+    bool refine(const MazeGrid& grid, size_t from, const std::vector<size_t>& waypoints, std::vector<size_t>& cells);
+
+    // Batched routes to one goal: solveGoalField() runs one Dijkstra search
+    // from the goal over the entrance nodes, stopping once every node of the
+    // starts' clusters is settled, and routeFrom() then needs only an
+    // in-cluster search per start. Both are const and touch only the
+    // caller's scratch, so threads may share the hierarchy while nothing
+    // rebuilds it.
+    void solveGoalField(const MazeGrid& grid, size_t goal, const size_t* starts, size_t startCount, GoalField& field) const;
+    // Length of the shortest route from start to field's goal, or -1 if
+    // there is none or start's cluster was not among the starts. waypoint
+    // is set to the first waypoint of a shortest route, in the form
+    // findRoute() gives them.
+    int routeFrom(const MazeGrid& grid, size_t start, const GoalField& field, Scratch& scratch, size_t& waypoint) const;
+
+    int getClusterSize() const { return clusterSize; }
+    size_t getNodeCount() const;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#include "PathQueue.h"
+#include <algorithm>
+
+PathQueue::PathQueue(unsigned threadCount)
+    : paths(nullptr), grid(nullptr), batch(0), running(0), goalPhaseLeft(0), busy(false), stopping(false), nextGoal(0), nextRoute(0) {
+    if(threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for(unsigned i = 0; i < threadCount; ++i) workers.emplace_back(&PathQueue::workerLoop, this);
+}
+
+PathQueue::~PathQueue() {
+    collect();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread& t : workers) t.join();
+}
+
+void PathQueue::request(int slot, size_t start, size_t goal) {
+    pendingIndex[slot] = static_cast<int>(pendingSlots.size());
+    requests.push_back(Request{start, goal, -1});
+    pendingSlots.push_back(slot);
+}
+
+void PathQueue::submit(const PathHierarchy& paths_, const MazeGrid& grid_) {
+    collect();
+    results.clear();
+    if(requests.empty()) return;
+    paths = &paths_;
+    grid = &grid_;
+    solving.swap(requests);
+    solvingSlots.swap(pendingSlots);
+    solvingIndex.swap(pendingIndex);
+    requests.clear();
+    pendingSlots.clear();
+    pendingIndex.clear();
+
+    // Group the starts by goal so each goal's field sees all of them.
+    std::unordered_map<size_t, int> goalIds;
+    goals.clear();
+    for(Request& r : solving) {
+        auto it = goalIds.emplace(r.goal, static_cast<int>(goals.size())).first;
+        if(it->second == static_cast<int>(goals.size())) goals.push_back(r.goal);
+        r.goalIndex = it->second;
+    }
+    firstStart.assign(goals.size() + 1, 0);
+    for(const Request& r : solving) ++firstStart[r.goalIndex + 1];
+    for(size_t g = 0; g < goals.size(); ++g) firstStart[g + 1] += firstStart[g];
+    goalStarts.resize(solving.size());
+    std::vector<int> fill(firstStart.begin(), firstStart.end() - 1);
+    for(const Request& r : solving) goalStarts[fill[r.goalIndex]++] = r.start;
+    if(fields.size() < goals.size()) fields.resize(goals.size());
+    results.resize(solving.size());
+
+    nextGoal = 0;
+    nextRoute = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = static_cast<unsigned>(workers.size());
+        goalPhaseLeft = running;
+        busy = true;
+        ++batch;
+    }
+    wake.notify_all();
+}
+
+const std::vector<PathQueue::Result>& PathQueue::collect() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!busy) return results;
+    done.wait(lock, [this] { return running == 0; });
+    busy = false;
+    for(size_t r = 0; r < results.size(); ++r) results[r].slot = solvingSlots[r];
+    return results;
+}
+
+void PathQueue::moveSlot(int from, int to) {
+    auto move = [from, to](std::unordered_map<int, int>& index, std::vector<int>& slots) {
+        auto it = index.find(from);
+        if(it == index.end()) return;
+        int request = it->second;
+        index.erase(it);
+        slots[request] = to;
+        if(to >= 0) index[to] = request;
+    };
+    move(pendingIndex, pendingSlots);
+    move(solvingIndex, solvingSlots);
+}
+
+void PathQueue::clear() {
+    collect();
+    results.clear();
+    requests.clear();
+    pendingSlots.clear();
+    pendingIndex.clear();
+}
+
+void PathQueue::workerLoop() {
+    PathHierarchy::Scratch scratch;
+    unsigned long long seen = 0;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || batch != seen; });
+            if(stopping) return;
+            seen = batch;
+        }
+        runBatch(scratch);
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--running == 0) done.notify_one();
+    }
+}
+
+// Routes read the goal fields, so no worker starts on routes until every
+// worker is done claiming goals; the last one out wakes the others.
+void PathQueue::runBatch(PathHierarchy::Scratch& scratch) {
+    int goalCount = static_cast<int>(goals.size());
+    for(int g = nextGoal++; g < goalCount; g = nextGoal++) {
+        paths->solveGoalField(*grid, goals[g], goalStarts.data() + firstStart[g], firstStart[g + 1] - firstStart[g], fields[g]);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(--goalPhaseLeft == 0) goalsDone.notify_all();
+        else goalsDone.wait(lock, [this] { return goalPhaseLeft == 0; });
+    }
+
+    int routeCount = static_cast<int>(solving.size());
+    for(int r = nextRoute++; r < routeCount; r = nextRoute++) {
+        const Request& request = solving[r];
+        Result& result = results[r];
+        result.start = request.start;
+        result.length = paths->routeFrom(*grid, request.start, fields[request.goalIndex], scratch, result.waypoint);
+    }
+}
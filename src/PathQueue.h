@@ -0,0 +1,89 @@
+#ifndef PATHQUEUE_H
+#define PATHQUEUE_H
+
+#include "MazeGrid.h"
+#include "PathHierarchy.h"
+#include <vector>
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+
+// Route requests collected during one tick and solved on a pool of worker
+// threads while the rest of the tick runs. Requests are grouped by goal
+// cell: each distinct goal gets one PathHierarchy::solveGoalField() search,
+// then every request is answered by an in-cluster search from its start.
+// Goals are solved in parallel, then routes. collect() waits for the batch,
+// so results arrive exactly one tick after their requests whatever the
+// thread timing, and a seed still replays the same game. No SFML dependency.
+class PathQueue {
+public:
+    struct Result {
+        int slot;        // enemy slot, or -1 if that enemy has been removed
+        size_t start;
+        size_t waypoint; // first waypoint toward the goal
+        int length;      // route length in steps, -1 if there is none
+    };
+
+private:
+    struct Request {
+        size_t start, goal;
+        int goalIndex; // into goals / fields
+    };
+
+    // Batch state, written by the main thread only while no batch runs.
+    const PathHierarchy* paths;
+    const MazeGrid* grid;
+    std::vector<Request> requests, solving;
+    std::vector<int> pendingSlots, solvingSlots; // by request, main thread only
+    // Request of each slot in pendingSlots / solvingSlots, so moveSlot() is
+    // O(1).
+    std::unordered_map<int, int> pendingIndex, solvingIndex;
+    std::vector<size_t> goals, goalStarts;
+    std::vector<int> firstStart; // starts of goal g are goalStarts[firstStart[g]] .. [firstStart[g + 1]]
+    std::vector<PathHierarchy::GoalField> fields;
+    std::vector<Result> results;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done, goalsDone;
+    unsigned long long batch; // bumped per submit()
+    unsigned running;         // workers still on the current batch
+    unsigned goalPhaseLeft;   // workers still claiming goals; routes wait for 0
+    bool busy, stopping;
+    // Work counters of the current batch: goals, then routes.
+    std::atomic<int> nextGoal, nextRoute;
+
+    void workerLoop();
+    void runBatch(PathHierarchy::Scratch& scratch);
+
+public:
+    // threadCount 0 uses one worker per hardware thread.
+    explicit PathQueue(unsigned threadCount = 0);
+    ~PathQueue();
+    PathQueue(const PathQueue&) = delete;
+    PathQueue& operator=(const PathQueue&) = delete;
+
+    // Queues a route for enemy slot from cell start to cell goal; at most
+    // one request per slot between submits.
+    void request(int slot, size_t start, size_t goal);
+    // Starts solving the queued requests. grid and paths must not change
+    // until collect() returns.
+    void submit(const PathHierarchy& paths_, const MazeGrid& grid_);
+    // Waits for the submitted batch and returns its results, valid until the
+    // next submit(). Empty if nothing was submitted.
+    const std::vector<Result>& collect();
+    // Enemy slot from now lives in slot to (to -1: removed); keeps pending
+    // results aimed at the right enemy across swap-removal. Remove the enemy
+    // in slot to before moving another one into it.
+    void moveSlot(int from, int to);
+    // Drops queued requests and the results of any running batch.
+    void clear();
+
+    std::size_t getPendingCount() const { return requests.size(); }
+    unsigned getThreadCount() const { return static_cast<unsigned>(workers.size()); }
+};
+
+#endif
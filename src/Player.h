@@ -2,28 +2,17 @@
 #define PLAYER_H
 
 #include "GameObject.h"
-#include <SFML/Graphics.hpp>
-#include <vector>
+#include "BulletPool.h"
 
-class Maze; 
-
-struct Bullet {
-    float x, y;
-    int dirX, dirY;
-    float speed;
-    bool active;
-
-    Bullet(float px, float py, int dx, int dy, float s):x(px), y(py), dirX(dx), dirY(dy), speed(s), active(true) {}
-};
+class MazeGrid;
 
 class Player : public MovableEntity{
 private:
-    int cellSize;
     float visionRadius;
     
-    sf::Clock damageCooldown; 
-    sf::Clock invisibilityTimer;
-    sf::Clock invisibilityClock;
+    // Timers run on simulation time (seconds left), advanced by update().
+    float damageCooldown;
+    float invisibilityLeft;
 
     float health;
     float maxHealth;
@@ -33,10 +22,10 @@ private:
     int initialX;
     int initialY;
     int ammo;
-    std::vector<Bullet> bullets;
+    BulletPool bullets;
     
 public:
-    Player(int startX, int startY, int cellSize_, float visionRadius_ = 3.0f);
+    Player(int startX, int startY, float visionRadius_ = 3.0f);
     virtual ~Player();
     
     int getCellX() const;
@@ -50,7 +39,8 @@ public:
     bool getCanKillEnemies() const;
     int getDeathCount() const;
     int getAmmo() const;
-    std::vector<Bullet>& getBullets();
+    BulletPool& getBullets();
+    const BulletPool& getBullets() const;
     
     void increaseHealth(float amount);
     void increaseVision(float amount);
@@ -58,7 +48,7 @@ public:
     void fire();
     
  
-    void updateBullets(int mazeCols, int mazeRows, const Maze* maze);
+    virtual void update(float deltaTime) override;
     
     void takeDamage(float amount);
     void respawn();
@@ -67,14 +57,14 @@ public:
     void setCanKillEnemies(bool canKill);
     
     virtual void move(int dx, int dy) override;
-    bool isInVision(int cellX, int cellY) const;
-    void drawAimArrow(sf::RenderWindow& window, int cellSize) const;
-    virtual void draw(sf::RenderWindow& window) const override;
 };
 
 
 namespace GameConstants {
     constexpr float INVISIBILITY_DURATION = 10.0f;
+    constexpr float DAMAGE_COOLDOWN = 1.0f;
+    constexpr float BULLET_SPEED = 30.0f;
+    constexpr int MAX_BULLETS = 1024; // bullet pool slots; firing fails when all are in flight
     constexpr int KILL_POWER_AMMO_REWARD = 6;
 }
 
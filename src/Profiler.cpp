@@ -0,0 +1,121 @@
+#include "Profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        Profiler::Section section;
+        int thread;
+        std::uint64_t startNs;
+        std::uint64_t durationNs;
+    };
+
+    // Timers fire a few dozen times per frame, so one lock is cheap enough
+    // and keeps the main and render threads' records consistent.
+    std::mutex lock;
+    std::uint64_t current[Profiler::SECTION_COUNT] = {};
+    std::uint64_t history[Profiler::SECTION_COUNT][Profiler::HISTORY] = {};
+    int historyCount[Profiler::SECTION_COUNT] = {};
+    int historyNext[Profiler::SECTION_COUNT] = {};
+    std::vector<TraceEvent> trace;
+    size_t traceNext = 0;
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::atomic<int> nextThread(1);
+
+    int threadNumber() {
+        thread_local int number = nextThread++;
+        return number;
+    }
+
+    double percentile(std::vector<std::uint64_t>& samples, double p) {
+        size_t k = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+        return samples[k] / 1e6;
+    }
+}
+
+const char* Profiler::sectionName(Section section) {
+    static const char* names[SECTION_COUNT] = { "input", "update", "bullets", "enemies", "enemies near", "enemies mid", "enemies far", "collisions", "draw", "draw maze", "draw entities", "draw hud" };
+    return names[section];
+}
+
+std::uint64_t Profiler::nowNanos() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::record(Section section, std::uint64_t startNs, std::uint64_t durationNs) {
+    int thread = threadNumber();
+    std::lock_guard<std::mutex> guard(lock);
+    current[section] += durationNs;
+    TraceEvent event = { section, thread, startNs, durationNs };
+    if(trace.size() < TRACE_CAPACITY) trace.push_back(event);
+    else trace[traceNext] = event;
+    traceNext = (traceNext + 1) % TRACE_CAPACITY;
+}
+
+void Profiler::endFrame(Section first, Section last) {
+    std::lock_guard<std::mutex> guard(lock);
+    for(int s = first; s <= last; ++s) {
+        history[s][historyNext[s]] = current[s];
+        historyNext[s] = (historyNext[s] + 1) % HISTORY;
+        historyCount[s] = std::min(historyCount[s] + 1, HISTORY);
+        current[s] = 0;
+    }
+}
+
+Profiler::Stats Profiler::stats(Section section) {
+    std::vector<std::uint64_t> samples;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        samples.assign(history[section], history[section] + historyCount[section]);
+    }
+    Stats result = { 0, 0, static_cast<int>(samples.size()) };
+    if(samples.empty()) return result;
+    result.p50Ms = percentile(samples, 0.50);
+    result.p99Ms = percentile(samples, 0.99);
+    return result;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(trace.size() < TRACE_CAPACITY) events = trace;
+        else {
+            events.assign(trace.begin() + traceNext, trace.end());
+            events.insert(events.end(), trace.begin(), trace.begin() + traceNext);
+        }
+    }
+
+    std::ofstream out(path);
+    if(!out.is_open()) return false;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"traceEvents\":[\n";
+    for(size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        out << "{\"name\":\"" << sectionName(e.section) << "\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":" << e.startNs / 1000.0
+            << ",\"dur\":" << e.durationNs / 1000.0 << ",\"pid\":1,\"tid\":" << e.thread << "}" << (i + 1 < events.size() ? ",\n" : "\n");
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+    return true;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> guard(lock);
+    std::fill(&current[0], &current[0] + SECTION_COUNT, 0);
+    std::fill(&historyCount[0], &historyCount[0] + SECTION_COUNT, 0);
+    std::fill(&historyNext[0], &historyNext[0] + SECTION_COUNT, 0);
+    trace.clear();
+    traceNext = 0;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Per-subsystem frame timing. PROFILE_SCOPE(section) times the enclosing
+// block; PROFILE_END_FRAME(first, last) closes a frame for a range of
+// sections and stores their totals in a ring of the last HISTORY frames,
+// from which stats() reports p50/p99. Every timed block is also kept as a
+// trace event for writeChromeTrace (chrome://tracing, Perfetto).
+//
+// Profiling is compiled in unless NDEBUG is defined, so release builds
+// (-DNDEBUG) contain none of it; -DENABLE_PROFILER forces it back on.
+// No SFML dependency.
+#if !defined(NDEBUG) || defined(ENABLE_PROFILER)
+#define PROFILER_ENABLED 1
+#endif
+
+#ifdef PROFILER_ENABLED
+
+#include <cstdint>
+#include <string>
+
+namespace Profiler {
+    // Main thread: INPUT..COLLISIONS, one frame per main-loop iteration;
+    // ENEMIES_* split ENEMIES by AI level-of-detail tier.
+    // Render thread: DRAW..DRAW_HUD, one frame per drawn frame.
+    enum Section { INPUT, UPDATE, BULLETS, ENEMIES, ENEMIES_NEAR, ENEMIES_MID, ENEMIES_FAR, COLLISIONS, DRAW, DRAW_MAZE, DRAW_ENTITIES, DRAW_HUD, SECTION_COUNT };
+
+    static constexpr int HISTORY = 256;
+    static constexpr int TRACE_CAPACITY = 1 << 16;
+
+    struct Stats {
+        double p50Ms, p99Ms;
+        int frames;
+    };
+
+    const char* sectionName(Section section);
+    std::uint64_t nowNanos();
+
+    void record(Section section, std::uint64_t startNs, std::uint64_t durationNs);
+    void endFrame(Section first, Section last);
+    Stats stats(Section section);
+    // Writes the buffered trace events (oldest first); false if the file
+    // could not be opened.
+    bool writeChromeTrace(const std::string& path);
+    void reset();
+
+    class ScopedTimer {
+    private:
+        Section section;
+        std::uint64_t start;
+    public:
+        explicit ScopedTimer(Section section_) : section(section_), start(nowNanos()) {}
+        ~ScopedTimer() { record(section, start, nowNanos() - start); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(section) Profiler::ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(section)
+#define PROFILE_END_FRAME(first, last) Profiler::endFrame(first, last)
+
+#else
+
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_END_FRAME(first, last) ((void)0)
+
+#endif
+
+#endif
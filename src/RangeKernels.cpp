@@ -0,0 +1,88 @@
+#include "RangeKernels.h"
+#include <algorithm>
+
+// MSVC does not define __SSE2__; x64 always has it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RANGE_KERNELS_SSE2 1
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(RANGE_KERNELS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace RangeKernels {
+
+// Scalar tail shared by every path; starts at 'from', which the SIMD loops
+// leave on a multiple of their width so no vector result straddles a word.
+static void radiusTail(const float* xs, const float* ys, std::size_t from, std::size_t n, float cx, float cy, float r2, std::uint32_t* mask) {
+    for(std::size_t i = from; i < n; ++i) {
+        float dx = xs[i] - cx;
+        float dy = ys[i] - cy;
+        if(dx * dx + dy * dy <= r2) mask[i / 32] |= 1u << (i % 32);
+    }
+}
+
+void withinRadiusScalar(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask) {
+    std::fill(mask, mask + maskWords(n), 0u);
+    radiusTail(xs, ys, 0, n, cx, cy, radius * radius, mask);
+}
+
+#if defined(__AVX2__)
+
+static inline unsigned radiusBits8(const float* xs, const float* ys, __m256 cx, __m256 cy, __m256 r2) {
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs), cx);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys), cy);
+    __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LE_OQ)));
+}
+
+void withinRadius(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask) {
+    std::fill(mask, mask + maskWords(n), 0u);
+    float r2 = radius * radius;
+    __m256 vcx = _mm256_set1_ps(cx), vcy = _mm256_set1_ps(cy), vr2 = _mm256_set1_ps(r2);
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        unsigned bits = radiusBits8(xs + i, ys + i, vcx, vcy, vr2) | (radiusBits8(xs + i + 8, ys + i + 8, vcx, vcy, vr2) << 8);
+        mask[i / 32] |= bits << (i % 32);
+    }
+    radiusTail(xs, ys, i, n, cx, cy, r2, mask);
+}
+
+const char* instructionSet() { return "avx2"; }
+
+#elif defined(RANGE_KERNELS_SSE2)
+
+static inline unsigned radiusBits4(const float* xs, const float* ys, __m128 cx, __m128 cy, __m128 r2) {
+    __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs), cx);
+    __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys), cy);
+    __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(d2, r2)));
+}
+
+void withinRadius(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask) {
+    std::fill(mask, mask + maskWords(n), 0u);
+    float r2 = radius * radius;
+    __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vr2 = _mm_set1_ps(r2);
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        unsigned bits = radiusBits4(xs + i, ys + i, vcx, vcy, vr2) | (radiusBits4(xs + i + 4, ys + i + 4, vcx, vcy, vr2) << 4);
+        mask[i / 32] |= bits << (i % 32);
+    }
+    radiusTail(xs, ys, i, n, cx, cy, r2, mask);
+}
+
+const char* instructionSet() { return "sse2"; }
+
+#else
+
+void withinRadius(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask) {
+    withinRadiusScalar(xs, ys, n, cx, cy, radius, mask);
+}
+
+const char* instructionSet() { return "scalar"; }
+
+#endif
+
+}
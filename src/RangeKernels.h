@@ -0,0 +1,48 @@
+#ifndef RANGEKERNELS_H
+#define RANGEKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Batch "is this point within range" tests over coordinate arrays. Results
+// are bitmasks: bit (i % 32) of mask[i / 32] is set when entity i is in range,
+// so callers need maskWords(n) words. The SIMD paths are picked at compile
+// time (AVX2 with -mavx2 / -march=native, otherwise SSE2 on x86-64) and test
+// 16 or 8 entities per iteration; the Scalar variants are the reference and
+// the fallback on other targets. No SFML dependency.
+namespace RangeKernels {
+    inline std::size_t maskWords(std::size_t n) { return (n + 31) / 32; }
+
+    // Entity i is in range when it lies within radius of (cx, cy).
+    void withinRadius(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask);
+
+    void withinRadiusScalar(const float* xs, const float* ys, std::size_t n, float cx, float cy, float radius, std::uint32_t* mask);
+
+    // Name of the compiled-in path: "avx2", "sse2" or "scalar".
+    const char* instructionSet();
+
+    inline unsigned lowestBit(std::uint32_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+    }
+
+    // Calls visit(i) for every set bit, in increasing order.
+    template <class Visit>
+    void forEachSet(const std::uint32_t* mask, std::size_t n, Visit visit) {
+        for(std::size_t w = 0; w < maskWords(n); ++w) {
+            for(std::uint32_t bits = mask[w]; bits != 0; bits &= bits - 1) {
+                visit(w * 32 + lowestBit(bits));
+            }
+        }
+    }
+}
+
+#endif
@@ -18,17 +18,19 @@ float Riddle::getReward() const { return 2.0f; }
 sf::Color Riddle::getMarkerColor() const { return sf::Color(255,200,50); }
 
 void Riddle::draw(sf::RenderWindow& window) const {
-    if(!solved) {
-        float px = x * cellSize + cellSize / 2;
-        float py = y * cellSize + cellSize / 2;
-        sf::CircleShape marker(8,6);
-        marker.setOrigin(8,8);
-        marker.setPosition(px, py);
-        marker.setFillColor(getMarkerColor());
-        marker.setOutlineColor(sf::Color(255,255,100));
-        marker.setOutlineThickness(2);
-        window.draw(marker);
-    }
+    if(!solved) drawMarker(window, x, y, cellSize, getMarkerColor());
+}
+
+void Riddle::drawMarker(sf::RenderWindow& window, float cellX, float cellY, int cellSize, sf::Color color) {
+    float px = cellX * cellSize + cellSize / 2;
+    float py = cellY * cellSize + cellSize / 2;
+    sf::CircleShape marker(8,6);
+    marker.setOrigin(8,8);
+    marker.setPosition(px, py);
+    marker.setFillColor(color);
+    marker.setOutlineColor(sf::Color(255,255,100));
+    marker.setOutlineThickness(2);
+    window.draw(marker);
 }
 
 
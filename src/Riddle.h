@@ -15,7 +15,6 @@ protected:
     bool solved;
     int cellSize;
     RiddleRewardType rewardType;
-    virtual sf::Color getMarkerColor() const;
 public:
     Riddle(const std::string& q = "", const std::string& a = "", int posX = 0, int posY = 0, int cs = 30, RiddleRewardType rt = VISION_REWARD);
     virtual ~Riddle();
@@ -25,14 +24,16 @@ public:
     void setSolved(bool s);
     RiddleRewardType getRewardType() const;
     virtual float getReward() const;
-    virtual void draw(sf::RenderWindow& window) const override;
+    virtual sf::Color getMarkerColor() const;
+    virtual void draw(sf::RenderWindow& window) const;
+    // Hexagon marker at cell (cellX, cellY); shared with snapshot rendering.
+    static void drawMarker(sf::RenderWindow& window, float cellX, float cellY, int cellSize, sf::Color color);
 };
 
 class EasyRiddle : public Riddle {
 public:
     EasyRiddle(const std::string& q, const std::string& a, int posX, int posY, int cs, RiddleRewardType rt = VISION_REWARD);
     virtual float getReward() const override;
-protected:
     virtual sf::Color getMarkerColor() const override;
 };
 
@@ -40,7 +41,6 @@ class HardRiddle : public Riddle {
 public:
     HardRiddle(const std::string& q, const std::string& a, int posX, int posY, int cs, RiddleRewardType rt = VISION_REWARD);
     virtual float getReward() const override;
-protected:
     virtual sf::Color getMarkerColor() const override;
 };
 
@@ -0,0 +1,23 @@
+#include "Rng.h"
+
+// splitmix64 finalizer; also used to expand one seed into xoshiro's state.
+static std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Rng::Rng(std::uint64_t seed_) {
+    seed(seed_);
+}
+
+void Rng::seed(std::uint64_t seed_) {
+    std::uint64_t x = seed_;
+    for(int i = 0; i < 4; ++i) state[i] = splitmix64(x);
+}
+
+std::uint64_t Rng::mix(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    return splitmix64(x);
+}
@@ -0,0 +1,49 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Small, fast, explicitly seeded random number generator (xoshiro256**).
+// Each game, generator or worker thread owns its own instance, so runs are
+// reproducible from a seed and threads never contend on shared state.
+// Satisfies UniformRandomBitGenerator, so it works with std::shuffle.
+class Rng {
+private:
+    std::uint64_t state[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef std::uint64_t result_type;
+
+    explicit Rng(std::uint64_t seed = 0);
+    void seed(std::uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() { return next(); }
+    std::uint64_t next() {
+        std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, n); n must be positive.
+    std::size_t below(std::size_t n) { return static_cast<std::size_t>(next() % n); }
+    // Uniform integer in [low, high].
+    int range(int low, int high) { return low + static_cast<int>(below(static_cast<std::size_t>(high - low) + 1)); }
+    bool coin() { return (next() >> 63) != 0; }
+
+    // Hashes (seed, stream) into an independent seed, e.g. per row or tile.
+    static std::uint64_t mix(std::uint64_t seed, std::uint64_t stream);
+};
+
+#endif
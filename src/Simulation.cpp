@@ -0,0 +1,197 @@
+#include "Simulation.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+Simulation::Simulation(const MazeGrid& grid_, PathQueue& pathQueue_, int startX, int startY, int finishX_, int finishY_)
+    : grid(grid_), finishX(finishX_), finishY(finishY_), player(startX, startY, 3.0f),
+      flowField(grid_.getCols(), grid_.getRows()), paths(grid_.getCols(), grid_.getRows()), pathQueue(pathQueue_), visibility(grid_.getCols(), grid_.getRows()), maxDetectionRadius(0), enemyIndex(grid_.getCols(), grid_.getRows()), riddleIndex(grid_.getCols(), grid_.getRows()),
+      elapsedTime(0), tickCount(0), outcome(RUNNING) {
+    flowField.compute(grid, startX, startY, CHASE_FIELD_DISTANCE);
+    paths.build(grid);
+    pathQueue.clear();
+    updateVisibility();
+}
+
+Simulation::~Simulation() {
+    pathQueue.clear();
+}
+
+void Simulation::spawnEnemies(Rng& rng, int count, float detectionRadius) {
+    pathQueue.clear();
+    lod.clear();
+    enemies.clear();
+    enemyIndex.clear();
+
+    int cols = grid.getCols();
+    int rows = grid.getRows();
+    const int minDistance = static_cast<int>(detectionRadius) + 2;
+    int startX = player.getCellX();
+    int startY = player.getCellY();
+    for(int i = 0; i < count; ++i) {
+        int ex, ey;
+        int attempts = 0;
+        bool tooClose, onExit;
+        do {
+            ex = rng.range(0, cols - 1);
+            ey = rng.range(0, rows - 1);
+            ++attempts;
+            tooClose = (std::abs(ex - startX) < minDistance) && (std::abs(ey - startY) < minDistance);
+            onExit = (ex == finishX && ey == finishY);
+        } while((tooClose || onExit) && attempts < 200);
+
+        if((std::abs(ex - startX) < minDistance) && (std::abs(ey - startY) < minDistance)) {
+            ex = std::min(cols - 1, startX + minDistance);
+            ey = std::min(rows - 1, startY + minDistance);
+        }
+
+        std::size_t slot = enemies.add(static_cast<float>(ex), static_cast<float>(ey), detectionRadius);
+        enemyIndex.update(static_cast<int>(slot), ex, ey);
+    }
+    maxDetectionRadius = count > 0 ? detectionRadius : 0;
+    lod.setDetectionRadius(maxDetectionRadius);
+    updateVisibility();
+}
+
+int Simulation::addRiddle(int x, int y) {
+    int id = static_cast<int>(riddleXs.size());
+    riddleIndex.update(id, x, y);
+    riddleXs.push_back(static_cast<float>(x));
+    riddleYs.push_back(static_cast<float>(y));
+    riddleSolved.push_back(0);
+    return id;
+}
+
+void Simulation::setRiddleSolved(int id) {
+    riddleSolved[id] = 1;
+}
+
+bool Simulation::movePlayer(int dx, int dy) {
+    if(outcome != RUNNING) return false;
+    if(!grid.canMove(player.getCellX(), player.getCellY(), dx, dy)) return false;
+    player.move(dx, dy);
+    updateVisibility();
+    if(player.getCellX() == finishX && player.getCellY() == finishY) outcome = REACHED_EXIT;
+    return true;
+}
+
+void Simulation::fire() {
+    if(outcome == RUNNING) player.fire();
+}
+
+bool Simulation::canPlayerSee(int x, int y) const {
+    if(!visibility.isVisible(x, y)) return false;
+    float dx = x - player.getX();
+    float dy = y - player.getY();
+    return dx * dx + dy * dy <= player.getVisionRadius() * player.getVisionRadius();
+}
+
+void Simulation::updateVisibility() {
+    visibility.update(grid, player.getCellX(), player.getCellY(), std::max(player.getVisionRadius(), maxDetectionRadius));
+}
+
+int Simulation::riddleAtPlayer() const {
+    for(int id = riddleIndex.first(player.getCellX(), player.getCellY()); id != CellIndex::NONE; id = riddleIndex.nextOf(id)) {
+        if(!riddleSolved[id]) return id;
+    }
+    return -1;
+}
+
+void Simulation::tick() {
+    if(outcome != RUNNING) return;
+    elapsedTime += TICK_SECONDS;
+    ++tickCount;
+
+    player.update(TICK_SECONDS);
+    updateVisibility();
+    enemies.beginTick();
+
+    {
+        PROFILE_SCOPE(Profiler::ENEMIES);
+        updateEnemies();
+    }
+    // After the enemies move, so bullets are swept against where they are
+    // this tick.
+    {
+        PROFILE_SCOPE(Profiler::BULLETS);
+        updateBullets();
+    }
+    {
+        PROFILE_SCOPE(Profiler::COLLISIONS);
+        checkEnemyCollisions();
+        removeDeadEnemies();
+    }
+
+    if(player.getHealth() <= 0) outcome = PLAYER_DEAD;
+}
+
+void Simulation::updateEnemies() {
+    for(const PathQueue::Result& result : pathQueue.collect()) {
+        if(result.slot >= 0 && result.length > 0) enemies.applyRoute(result.slot, result.start, result.waypoint, paths, grid);
+    }
+
+    int targetX = player.getCellX();
+    int targetY = player.getCellY();
+    if(targetX != flowField.getTargetX() || targetY != flowField.getTargetY()) {
+        flowField.compute(grid, targetX, targetY, CHASE_FIELD_DISTANCE);
+    }
+    if(!player.getIsInvisible()) {
+        lod.tick(enemies, player.getX(), player.getY(), tickCount, TICK_SECONDS, [this](std::size_t i, float deltaTime) { updateEnemy(i, deltaTime); });
+    }
+    pathQueue.submit(paths, grid);
+}
+
+// Detection needs line of sight as well as range.
+void Simulation::updateEnemy(std::size_t i, float deltaTime) {
+    if(!enemies.isAlive(i)) return;
+    if(enemies.inDetectionRange(i, player.getX(), player.getY()) && visibility.isVisible(enemies.getCellX(i), enemies.getCellY(i))) enemies.hunt(i, HUNT_SECONDS);
+    if(!enemies.isHunting(i)) return;
+
+    enemies.endHuntTick(i, deltaTime);
+    int x = enemies.getCellX(i);
+    int y = enemies.getCellY(i);
+    int targetX = player.getCellX();
+    int targetY = player.getCellY();
+    if(flowField.getDirection(x, y) >= 0 || (x == targetX && y == targetY)) enemies.chase(i, player.getX(), player.getY(), flowField, grid, deltaTime);
+    else if(enemies.followRoute(i, targetX, targetY, paths, grid, deltaTime)) {
+        pathQueue.request(static_cast<int>(i), grid.index(x, y), grid.index(targetX, targetY));
+    }
+    enemyIndex.update(static_cast<int>(i), enemies.getCellX(i), enemies.getCellY(i));
+}
+
+void Simulation::checkEnemyCollisions() {
+    if(player.getIsInvisible()) return;
+    for(int id = enemyIndex.first(player.getCellX(), player.getCellY()); id != CellIndex::NONE; id = enemyIndex.nextOf(id)) {
+        player.takeDamage(1.0f);
+    }
+}
+
+// Each bullet stops at the first enemy on any cell it passes through this
+// tick. An enemy killed by one bullet leaves the index at once, so later
+// bullets fly on.
+void Simulation::updateBullets() {
+    player.getBullets().update(grid, TICK_SECONDS, [this](int x, int y) {
+        int id = enemyIndex.first(x, y);
+        if(id == CellIndex::NONE) return false;
+        if(enemies.takeDamage(id, 10.0f)) enemyIndex.remove(id);
+        return true;
+    });
+}
+
+// Swap-removes dead enemies so the store stays dense; the enemy moved into a
+// freed slot is re-filed in the cell index, the path queue and the AI tiers
+// under its new slot.
+void Simulation::removeDeadEnemies() {
+    for(std::size_t i = enemies.size(); i-- > 0;) {
+        if(enemies.isAlive(i)) continue;
+        int last = static_cast<int>(enemies.size()) - 1;
+        enemyIndex.remove(last);
+        pathQueue.moveSlot(static_cast<int>(i), -1);
+        pathQueue.moveSlot(last, static_cast<int>(i));
+        lod.moveSlot(static_cast<int>(i), -1);
+        lod.moveSlot(last, static_cast<int>(i));
+        enemies.removeAt(i);
+        if(static_cast<int>(i) != last) enemyIndex.update(static_cast<int>(i), enemies.getCellX(i), enemies.getCellY(i));
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "MazeGrid.h"
+#include "Player.h"
+#include "EnemyStore.h"
+#include "FlowField.h"
+#include "PathHierarchy.h"
+#include "PathQueue.h"
+#include "AiLod.h"
+#include "CellIndex.h"
+#include "Visibility.h"
+#include "Rng.h"
+#include <vector>
+#include <cstddef>
+
+// One level's gameplay without a window, audio or textures: the player and
+// bullets, enemies and riddle cells on a finished MazeGrid, advanced in fixed
+// ticks. Game drives it from keyboard events and draws it; tools/HeadlessSim
+// drives it from a script. Riddle questions and rewards stay with the caller.
+// No SFML dependency.
+class Simulation {
+public:
+    static const int TICK_RATE = 120;
+    static constexpr float TICK_SECONDS = 1.0f / TICK_RATE;
+    // Path steps around the player covered by the flow field.
+    static const int CHASE_FIELD_DISTANCE = 24;
+    // Enemies keep hunting the player this long after losing sight.
+    static constexpr float HUNT_SECONDS = 3.0f;
+
+    enum Outcome { RUNNING, REACHED_EXIT, PLAYER_DEAD };
+
+private:
+    const MazeGrid& grid;
+    int finishX, finishY;
+    Player player;
+    EnemyStore enemies;
+    // Shortest-path directions toward the player's cell out to
+    // CHASE_FIELD_DISTANCE steps, rebuilt only when the player changes cell
+    // and shared by every chasing enemy. Hunters farther away plan routes
+    // through paths, built once per level.
+    FlowField flowField;
+    PathHierarchy paths;
+    // Hunters that need a route queue it here during one tick's enemy update;
+    // the batch is solved on worker threads while the tick goes on and its
+    // waypoints are handed out at the start of the next enemy update. Owned
+    // by the caller so its threads outlive the level.
+    PathQueue& pathQueue;
+    // Decides which enemies run each tick by their distance to the player.
+    AiLod lod;
+    // Line of sight from the player's cell out to the larger of the vision
+    // radius and the enemies' detection radius; recomputed only when the
+    // player changes cell or the radius changes. Drawing, enemy detection
+    // and riddle markers all read it.
+    Visibility visibility;
+    float maxDetectionRadius;
+    // Which enemies / riddles stand on each cell; ids are enemy slots and
+    // riddle indices. Dead enemies are removed on death.
+    CellIndex enemyIndex;
+    CellIndex riddleIndex;
+    std::vector<float> riddleXs, riddleYs;
+    std::vector<unsigned char> riddleSolved;
+    float elapsedTime;
+    unsigned long long tickCount;
+    Outcome outcome;
+
+    void updateEnemies();
+    void updateEnemy(std::size_t i, float deltaTime);
+    void checkEnemyCollisions();
+    void updateBullets();
+    void removeDeadEnemies();
+    void updateVisibility();
+
+public:
+    // Clears pathQueue for the new level.
+    Simulation(const MazeGrid& grid_, PathQueue& pathQueue_, int startX, int startY, int finishX_, int finishY_);
+    // Waits for pathQueue's workers to finish with this level's paths.
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Places count enemies away from the player's start and off the exit.
+    void spawnEnemies(Rng& rng, int count, float detectionRadius = 5.0f);
+    int addRiddle(int x, int y);
+    void setRiddleSolved(int id);
+
+    // Player actions, applied immediately (between ticks) like key presses.
+    // movePlayer returns false if a wall blocks the step.
+    bool movePlayer(int dx, int dy);
+    void fire();
+    // Unsolved riddle on the player's cell, or -1.
+    int riddleAtPlayer() const;
+    // Cell (x, y) is in the player's line of sight and vision radius.
+    bool canPlayerSee(int x, int y) const;
+    // Tier radii and update rates for enemy AI; see AiLod.
+    void setAiLodConfig(const AiLod::Config& config) { lod.setConfig(config); }
+
+    void tick();
+
+    Outcome getOutcome() const { return outcome; }
+    float getElapsedTime() const { return elapsedTime; }
+    unsigned long long getTickCount() const { return tickCount; }
+    Player& getPlayer() { return player; }
+    const Player& getPlayer() const { return player; }
+    const EnemyStore& getEnemies() const { return enemies; }
+    const AiLod& getAiLod() const { return lod; }
+    const Visibility& getVisibility() const { return visibility; }
+    std::size_t getRiddleCount() const { return riddleXs.size(); }
+    const float* getRiddleXs() const { return riddleXs.data(); }
+    const float* getRiddleYs() const { return riddleYs.data(); }
+};
+
+#endif
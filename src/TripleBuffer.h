@@ -0,0 +1,42 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Single-producer / single-consumer triple buffer. The writer fills
+// writeSlot() and publish()es it; the reader acquire()s the newest published
+// slot and reads it for as long as it likes. Neither side ever waits: the
+// third slot is always free for the writer, and intermediate publications the
+// reader did not get to are simply skipped. Slots are reused, so a T holding
+// vectors keeps their capacity. No SFML dependency.
+template <class T>
+class TripleBuffer {
+private:
+    static const unsigned INDEX_MASK = 3;
+    static const unsigned FRESH = 4; // middle holds a slot the reader has not seen
+
+    T slots[3];
+    std::atomic<unsigned> middle;
+    unsigned back;  // writer only
+    unsigned front; // reader only
+
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    // Writer side. The slot holds stale data from an earlier publication,
+    // so every field must be rewritten before publish().
+    T& writeSlot() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader side. Returns true if a newer slot was swapped in.
+    bool acquire() {
+        if(!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& readSlot() const { return slots[front]; }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "Visibility.h"
+#include <cstdlib>
+
+Visibility::Visibility(int cols_, int rows_)
+    : cols(cols_), rows(rows_), originX(-1), originY(-1), radius(-1),
+      bits((static_cast<size_t>(cols_) * rows_ + 63) / 64, 0), seen(static_cast<size_t>(cols_) * rows_, 0) {}
+
+bool Visibility::update(const MazeGrid& grid, int originX_, int originY_, float radius_) {
+    if(originX_ == originX && originY_ == originY && radius_ == radius) return false;
+    originX = originX_;
+    originY = originY_;
+    radius = radius_;
+
+    for(size_t cell : visible) bits[cell >> 6] = 0;
+    visible.clear();
+    for(size_t cell : reached) seen[cell] = 0;
+    reached.clear();
+    if(!grid.inBounds(originX, originY)) return true;
+
+    // A sight line passes through cells up to ~0.7 outside the circle, so
+    // the search runs one cell further than the radius.
+    float searchRadius = radius + 1.0f;
+    size_t origin = grid.index(originX, originY);
+    seen[origin] = 1;
+    reached.push_back(origin);
+    for(size_t head = 0; head < reached.size(); ++head) {
+        size_t cell = reached[head];
+        int x = grid.cellX(cell);
+        int y = grid.cellY(cell);
+        float dx = static_cast<float>(x - originX);
+        float dy = static_cast<float>(y - originY);
+        if(dx * dx + dy * dy <= radius * radius && lineOfSight(grid, originX, originY, x, y)) {
+            bits[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+            visible.push_back(cell);
+        }
+        for(int dir = 0; dir < 4; ++dir) {
+            if(grid.hasWall(cell, dir)) continue;
+            int nx = x + MazeGrid::DX[dir];
+            int ny = y + MazeGrid::DY[dir];
+            float ndx = static_cast<float>(nx - originX);
+            float ndy = static_cast<float>(ny - originY);
+            if(ndx * ndx + ndy * ndy > searchRadius * searchRadius) continue;
+            size_t next = grid.neighbor(cell, dir);
+            if(seen[next]) continue;
+            seen[next] = 1;
+            reached.push_back(next);
+        }
+    }
+    return true;
+}
+
+// Walks the cells crossed by the segment between the two cell centres and
+// fails at the first wall it crosses. Where the segment passes exactly
+// through a corner, either way around the corner may be open.
+bool Visibility::lineOfSight(const MazeGrid& grid, int x0, int y0, int x1, int y1) const {
+    int nx = std::abs(x1 - x0);
+    int ny = std::abs(y1 - y0);
+    int stepX = x1 > x0 ? 1 : -1;
+    int stepY = y1 > y0 ? 1 : -1;
+    int dirX = stepX > 0 ? 1 : 3;
+    int dirY = stepY > 0 ? 2 : 0;
+
+    int x = x0;
+    int y = y0;
+    for(int ix = 0, iy = 0; ix < nx || iy < ny;) {
+        // Next vertical boundary at t = (ix + 0.5) / nx, horizontal at
+        // (iy + 0.5) / ny; compared without division.
+        long long tx = static_cast<long long>(2 * ix + 1) * ny;
+        long long ty = static_cast<long long>(2 * iy + 1) * nx;
+        size_t cell = grid.index(x, y);
+        if(tx == ty) {
+            bool viaX = !grid.hasWall(cell, dirX) && !grid.hasWall(grid.index(x + stepX, y), dirY);
+            bool viaY = !grid.hasWall(cell, dirY) && !grid.hasWall(grid.index(x, y + stepY), dirX);
+            if(!viaX && !viaY) return false;
+            x += stepX;
+            y += stepY;
+            ++ix;
+            ++iy;
+        } else if(tx < ty) {
+            if(grid.hasWall(cell, dirX)) return false;
+            x += stepX;
+            ++ix;
+        } else {
+            if(grid.hasWall(cell, dirY)) return false;
+            y += stepY;
+            ++iy;
+        }
+    }
+    return true;
+}
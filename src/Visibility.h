@@ -0,0 +1,47 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include "MazeGrid.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Cells in line of sight of one origin cell, respecting the maze walls. A
+// breadth-first search through open passages bounds the candidates to cells
+// near the radius that are reachable at all; each candidate is then kept if
+// the straight line between cell centres crosses no wall. The result is a
+// bitset plus the list of visible cells, cached until the origin cell or the
+// radius changes. No SFML dependency.
+class Visibility {
+private:
+    int cols, rows;
+    int originX, originY;
+    float radius;
+    std::vector<std::uint64_t> bits;
+    std::vector<size_t> visible;
+    // BFS scratch: candidates found by the last search, cleared lazily.
+    std::vector<size_t> reached;
+    std::vector<unsigned char> seen;
+
+    bool lineOfSight(const MazeGrid& grid, int x0, int y0, int x1, int y1) const;
+
+public:
+    Visibility(int cols_, int rows_);
+
+    // Recomputes only when the origin cell or radius differs from the last
+    // call; returns true if it did.
+    bool update(const MazeGrid& grid, int originX_, int originY_, float radius_);
+
+    bool isVisible(int x, int y) const {
+        if(static_cast<unsigned>(x) >= static_cast<unsigned>(cols) || static_cast<unsigned>(y) >= static_cast<unsigned>(rows)) return false;
+        size_t i = static_cast<size_t>(y) * cols + x;
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    // Visible cell indices (y * cols + x), origin first.
+    const std::vector<size_t>& getVisibleCells() const { return visible; }
+    int getOriginX() const { return originX; }
+    int getOriginY() const { return originY; }
+    float getRadius() const { return radius; }
+};
+
+#endif
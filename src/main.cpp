@@ -1,7 +1,15 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
 
-int main() {
+int main(int argc, char** argv) {
     Game game;
+    // --seed N replays the same level every time; --speed X runs the
+    // simulation X times faster (or slower) than real time.
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(!std::strcmp(argv[i], "--seed")) game.setSeed(std::strtoull(argv[i + 1], nullptr, 10));
+        else if(!std::strcmp(argv[i], "--speed")) game.setTimeScale(static_cast<float>(std::atof(argv[i + 1])));
+    }
     game.run();
     return 0;
-}
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+// Headless game runner for soak and performance testing: plays whole levels
+// through Simulation with no window, audio or textures, driven either by an
+// input script or by a built-in autopilot that walks to the exit, and reports
+// ticks per second. Depends only on the game core, not on SFML.
+//
+// Usage: headless_sim [--games N] [--seed S] [--cols N] [--rows N]
+//                     [--algorithm NAME] [--enemies N] [--ammo N]
+//                     [--max-ticks N] [--script FILE] [--min-tps X] [--verbose]
+//                     [--trace FILE] [--lod-near R] [--lod-mid R]
+//                     [--lod-interval N]
+//
+// A script has one "<tick> <action>" per line, action being up, down, left,
+// right or fire; it is replayed from the start of every game. Lines starting
+// with '#' are ignored. Without a script the autopilot steps toward the exit
+// every 15 ticks (8 cells/s) and fires every 60 ticks.
+// Exits with status 2 if --min-tps is given and throughput falls below it.
+// Unless built with -DNDEBUG, per-tick p50/p99 of the simulation's profiled
+// sections are reported and --trace writes them as a Chrome trace.
+// --lod-* set the enemy AI tiers (see AiLod); the mean number of enemies in
+// and updated per tier each tick is always reported. A huge --lod-near
+// updates every enemy every tick.
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "Simulation.h"
+#include "FlowField.h"
+#include "Rng.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct ScriptEvent {
+    unsigned long long tick;
+    int moveX, moveY;
+    bool fire;
+};
+
+static bool loadScript(const std::string& path, std::vector<ScriptEvent>& events) {
+    std::ifstream in(path);
+    if(!in) return false;
+    std::string line;
+    while(std::getline(in, line)) {
+        if(line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        ScriptEvent e = {0, 0, 0, false};
+        std::string action;
+        if(!(fields >> e.tick >> action)) continue;
+        if(action == "up") e.moveY = -1;
+        else if(action == "down") e.moveY = 1;
+        else if(action == "left") e.moveX = -1;
+        else if(action == "right") e.moveX = 1;
+        else if(action == "fire") e.fire = true;
+        else continue;
+        events.push_back(e);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const ScriptEvent& a, const ScriptEvent& b) { return a.tick < b.tick; });
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 100;
+    std::uint64_t seed = 1;
+    int cols = 30;
+    int rows = 20;
+    std::string algorithm = "backtracker";
+    int enemyCount = -1;
+    int ammo = 20;
+    unsigned long long maxTicks = 120ULL * 60 * 5;
+    std::string scriptPath;
+    double minTicksPerSecond = 0;
+    bool verbose = false;
+    std::string tracePath;
+    AiLod::Config lodConfig = AiLod::DEFAULT_CONFIG;
+
+    for(int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if(!std::strcmp(argv[i], "--games") && hasValue) games = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if(!std::strcmp(argv[i], "--cols") && hasValue) cols = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--rows") && hasValue) rows = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--algorithm") && hasValue) algorithm = argv[++i];
+        else if(!std::strcmp(argv[i], "--enemies") && hasValue) enemyCount = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--ammo") && hasValue) ammo = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--max-ticks") && hasValue) maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        else if(!std::strcmp(argv[i], "--script") && hasValue) scriptPath = argv[++i];
+        else if(!std::strcmp(argv[i], "--min-tps") && hasValue) minTicksPerSecond = std::atof(argv[++i]);
+        else if(!std::strcmp(argv[i], "--verbose")) verbose = true;
+        else if(!std::strcmp(argv[i], "--trace") && hasValue) tracePath = argv[++i];
+        else if(!std::strcmp(argv[i], "--lod-near") && hasValue) lodConfig.nearRadius = static_cast<float>(std::atof(argv[++i]));
+        else if(!std::strcmp(argv[i], "--lod-mid") && hasValue) lodConfig.midRadius = static_cast<float>(std::atof(argv[++i]));
+        else if(!std::strcmp(argv[i], "--lod-interval") && hasValue) lodConfig.midInterval = std::atoi(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--games N] [--seed S] [--cols N] [--rows N] [--algorithm NAME] [--enemies N] [--ammo N] [--max-ticks N] [--script FILE] [--min-tps X] [--verbose] [--trace FILE] [--lod-near R] [--lod-mid R] [--lod-interval N]\n";
+            return 1;
+        }
+    }
+    if(games <= 0 || cols < 6 || rows < 6) {
+        std::cerr << "Need at least one game and a maze of at least 6x6\n";
+        return 1;
+    }
+
+    std::vector<ScriptEvent> script;
+    if(!scriptPath.empty() && !loadScript(scriptPath, script)) {
+        std::cerr << "Cannot read script " << scriptPath << "\n";
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration simTime{};
+    Clock::time_point runStart = Clock::now();
+    unsigned long long totalTicks = 0;
+    int won = 0, lost = 0, timedOut = 0;
+    // One pool of route workers for every game.
+    PathQueue pathQueue;
+    double tierCounts[AiLod::TIER_COUNT] = {}, tierUpdates[AiLod::TIER_COUNT] = {};
+
+    for(int g = 0; g < games; ++g) {
+        // Same level layout as Game: one seed drives the maze, riddles and enemies.
+        Rng rng(Rng::mix(seed, static_cast<std::uint64_t>(g)));
+        MazeGrid grid(cols, rows);
+        MazeGenerator* generator = createMazeGenerator(algorithm, grid, rng.next());
+        if(!generator) {
+            std::cerr << "Unknown algorithm: " << algorithm << "\n";
+            return 1;
+        }
+        generator->run();
+        delete generator;
+
+        int finishX = cols - 1, finishY = rows - 1;
+        Simulation sim(grid, pathQueue, 0, 0, finishX, finishY);
+        sim.setAiLodConfig(lodConfig);
+        for(int r = 0; r < 10; ++r) sim.addRiddle(rng.range(2, cols - 3), rng.range(2, rows - 3));
+        sim.spawnEnemies(rng, enemyCount >= 0 ? enemyCount : rng.range(3, 5));
+        if(ammo > 0) {
+            sim.getPlayer().setCanKillEnemies(true);
+            sim.getPlayer().addAmmo(ammo);
+        }
+
+        FlowField toExit(cols, rows);
+        toExit.compute(grid, finishX, finishY);
+        std::size_t nextEvent = 0;
+
+        Clock::time_point start = Clock::now();
+        while(sim.getOutcome() == Simulation::RUNNING && sim.getTickCount() < maxTicks) {
+            unsigned long long tick = sim.getTickCount();
+            if(!script.empty()) {
+                for(; nextEvent < script.size() && script[nextEvent].tick <= tick; ++nextEvent) {
+                    const ScriptEvent& e = script[nextEvent];
+                    if(e.fire) sim.fire();
+                    else sim.movePlayer(e.moveX, e.moveY);
+                }
+            } else {
+                const Player& player = sim.getPlayer();
+                if(tick % 15 == 0) {
+                    int dir = toExit.getDirection(player.getCellX(), player.getCellY());
+                    if(dir >= 0) sim.movePlayer(MazeGrid::DX[dir], MazeGrid::DY[dir]);
+                }
+                if(tick % 60 == 0) sim.fire();
+            }
+            sim.tick();
+            const AiLod::Stats& lodStats = sim.getAiLod().getStats();
+            for(int t = 0; t < AiLod::TIER_COUNT; ++t) {
+                tierCounts[t] += lodStats.counts[t];
+                tierUpdates[t] += lodStats.updated[t];
+            }
+            PROFILE_END_FRAME(Profiler::BULLETS, Profiler::COLLISIONS);
+        }
+        simTime += Clock::now() - start;
+        totalTicks += sim.getTickCount();
+
+        const char* result = "timeout";
+        if(sim.getOutcome() == Simulation::REACHED_EXIT) { ++won; result = "exit"; }
+        else if(sim.getOutcome() == Simulation::PLAYER_DEAD) { ++lost; result = "dead"; }
+        else ++timedOut;
+        if(verbose) {
+            std::cout << "game " << g << ": " << result << " after " << sim.getTickCount() << " ticks ("
+                      << sim.getElapsedTime() << " s simulated), " << sim.getEnemies().size() << " enemies left\n";
+        }
+    }
+
+    double simSeconds = std::chrono::duration<double>(simTime).count();
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    double ticksPerSecond = simSeconds > 0 ? totalTicks / simSeconds : 0;
+    std::cout << games << " games on " << cols << "x" << rows << " (" << algorithm << "): "
+              << won << " reached the exit, " << lost << " died, " << timedOut << " timed out\n";
+    std::cout << "ticks:      " << totalTicks << " (" << totalTicks / static_cast<double>(Simulation::TICK_RATE) << " s simulated)\n";
+    const char* tierNames[AiLod::TIER_COUNT] = { "near", "mid", "far" };
+    std::cout << "ai tiers:  ";
+    for(int t = 0; t < AiLod::TIER_COUNT; ++t) {
+        double ticks = totalTicks > 0 ? static_cast<double>(totalTicks) : 1.0;
+        std::cout << " " << tierNames[t] << " " << tierCounts[t] / ticks << " (" << tierUpdates[t] / ticks << " updated/tick)";
+    }
+    std::cout << "\n";
+    std::cout << "throughput: " << ticksPerSecond << " ticks/s, " << (wallSeconds > 0 ? games * 60.0 / wallSeconds : 0) << " games/min\n";
+#ifdef PROFILER_ENABLED
+    for(int s = Profiler::BULLETS; s <= Profiler::COLLISIONS; ++s) {
+        Profiler::Stats stats = Profiler::stats(static_cast<Profiler::Section>(s));
+        std::cout << Profiler::sectionName(static_cast<Profiler::Section>(s)) << ": p50 " << stats.p50Ms << " ms, p99 " << stats.p99Ms
+                  << " ms (last " << stats.frames << " ticks)\n";
+    }
+    if(!tracePath.empty()) {
+        if(Profiler::writeChromeTrace(tracePath)) std::cout << "trace:      " << tracePath << "\n";
+        else std::cerr << "Error: could not write " << tracePath << "\n";
+    }
+#else
+    if(!tracePath.empty()) std::cerr << "Warning: --trace ignored, profiling is compiled out (NDEBUG)\n";
+#endif
+
+    if(minTicksPerSecond > 0 && ticksPerSecond < minTicksPerSecond) {
+        std::cerr << "Throughput below --min-tps " << minTicksPerSecond << "\n";
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Headless maze generator: builds a maze of any size from a seed with any of
+// the generation algorithms, reports throughput and peak memory, and can dump
+// the result to a file.
+// Depends only on the maze core (MazeGrid, MazeGenerator), not on SFML.
+//
+// Usage: maze_gen [--cols N] [--rows N] [--seed S] [--algorithm NAME|all]
+//                 [--threads N] [--check] [--out FILE] [--format ascii|bin]
+//        maze_gen [--cols N] [--rows N] [--seed S] --window W [--check]
+//
+// With --window, rows are streamed through a W-row window (MazeStream), so
+// --rows can exceed what fits in memory. The full maze never exists at once,
+// so --out is rejected with it, and --check instead scrolls back to sample
+// rows after they were evicted and compares them byte for byte with the
+// rows first produced.
+// Exits with status 1 if --check finds a maze that is not perfect or a
+// regenerated row that differs.
+
+#include "MazeGrid.h"
+#include "MazeGenerator.h"
+#include "MazeStream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+static long peakMemoryKB() {
+#ifndef _WIN32
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+// One text line per wall row: "+--+" for top walls, "|  |" for left walls.
+static void writeAscii(std::ostream& out, const MazeGrid& grid) {
+    for(int y = 0; y < grid.getRows(); ++y) {
+        for(int x = 0; x < grid.getCols(); ++x) out << (grid.hasWall(grid.index(x, y), 0) ? "+--" : "+  ");
+        out << "+\n";
+        for(int x = 0; x < grid.getCols(); ++x) out << (grid.hasWall(grid.index(x, y), 3) ? "|  " : "   ");
+        out << "|\n";
+    }
+    for(int x = 0; x < grid.getCols(); ++x) out << "+--";
+    out << "+\n";
+}
+
+// Header line, then one byte per cell with the four wall bits (row-major).
+static void writeBinary(std::ostream& out, const MazeGrid& grid, std::uint64_t seed) {
+    out << "MAZE " << grid.getCols() << " " << grid.getRows() << " " << seed << "\n";
+    std::string row(grid.getCols(), '\0');
+    for(int y = 0; y < grid.getRows(); ++y) {
+        for(int x = 0; x < grid.getCols(); ++x) row[x] = static_cast<char>(grid.bits(grid.index(x, y)) & MazeGrid::ALL_WALLS);
+        out.write(row.data(), row.size());
+    }
+}
+
+int main(int argc, char** argv) {
+    int cols = 1000;
+    std::int64_t rows = 1000;
+    std::uint64_t seed = 1;
+    std::string outPath;
+    std::string format = "bin";
+    std::string algorithm = "backtracker";
+    int window = 0;
+    unsigned threads = 0;
+    bool check = false;
+
+    for(int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if(!std::strcmp(argv[i], "--cols") && hasValue) cols = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--rows") && hasValue) rows = std::strtoll(argv[++i], nullptr, 10);
+        else if(!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if(!std::strcmp(argv[i], "--algorithm") && hasValue) algorithm = argv[++i];
+        else if(!std::strcmp(argv[i], "--window") && hasValue) window = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--threads") && hasValue) threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if(!std::strcmp(argv[i], "--check")) check = true;
+        else if(!std::strcmp(argv[i], "--out") && hasValue) outPath = argv[++i];
+        else if(!std::strcmp(argv[i], "--format") && hasValue) format = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--cols N] [--rows N] [--seed S] [--algorithm NAME|all] [--threads N] [--check] [--window W] [--out FILE] [--format ascii|bin]\n";
+            return 1;
+        }
+    }
+    if(cols <= 0 || rows <= 0) {
+        std::cerr << "Error: --cols and --rows must be positive\n";
+        return 1;
+    }
+
+    if(window > 0) {
+        if(!outPath.empty()) {
+            std::cerr << "Error: --out needs the whole maze and cannot be used with --window\n";
+            return 1;
+        }
+        // About 64 rows spread over the stream, copied when first produced.
+        std::int64_t sampleStride = std::max<std::int64_t>(1, rows / 64);
+        std::vector<std::int64_t> sampleRows;
+        std::vector<std::string> samples;
+        auto takeSamples = [&](const MazeStream& stream) {
+            if(!check) return;
+            std::int64_t y = sampleRows.empty() ? 0 : sampleRows.back() + sampleStride;
+            for(; y <= stream.getLastRow(); y += sampleStride) {
+                std::string row(cols, '\0');
+                for(int x = 0; x < cols; ++x) row[x] = static_cast<char>(stream.bits(x, y));
+                sampleRows.push_back(y);
+                samples.push_back(row);
+            }
+        };
+
+        auto begin = std::chrono::steady_clock::now();
+        MazeGrid ring(cols, window);
+        MazeStream stream(ring, seed);
+        takeSamples(stream);
+        for(std::int64_t first = window; first + window <= rows; first += window) {
+            stream.setWindow(first);
+            takeSamples(stream);
+        }
+        // The last, partial window; the first window is always generated.
+        if(rows > window) {
+            stream.setWindow(rows - window);
+            takeSamples(stream);
+        }
+        std::int64_t generatedRows = std::max<std::int64_t>(rows, window);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::cout << "\nstream (eller), window " << window << " rows\n";
+        std::cout << "time:        " << seconds << " s\n";
+        std::cout << "throughput:  " << (seconds > 0 ? static_cast<double>(cols) * generatedRows / seconds : 0) << " cells/s\n";
+        std::cout << "window:      " << ring.memoryBytes() / 1024 << " KB\n";
+        std::cout << "checkpoints: " << stream.checkpointBytes() / 1024 << " KB, every " << stream.getCheckpointInterval() << " rows\n";
+
+        bool regenerated = true;
+        if(check) {
+            // Newest first, so each sample is replayed from a checkpoint
+            // rather than reached by generating forward.
+            int evicted = 0;
+            for(size_t s = sampleRows.size(); s-- > 0;) {
+                std::int64_t y = sampleRows[s];
+                if(stream.isResident(y)) continue;
+                stream.setWindow(y);
+                ++evicted;
+                for(int x = 0; x < cols; ++x) {
+                    if(stream.bits(x, y) != static_cast<unsigned char>(samples[s][x])) regenerated = false;
+                }
+            }
+            std::cout << "regenerated: " << evicted << " evicted rows, " << (regenerated ? "identical" : "DIFFERENT") << "\n";
+        }
+        std::cout << "peak memory: " << peakMemoryKB() << " KB\n";
+        return regenerated ? 0 : 1;
+    }
+    if(rows > std::numeric_limits<int>::max()) {
+        std::cerr << "Error: more than " << std::numeric_limits<int>::max() << " rows needs --window\n";
+        return 1;
+    }
+
+    std::vector<std::string> algorithms;
+    if(algorithm == "all") algorithms = getMazeGeneratorNames();
+    else algorithms.push_back(algorithm);
+
+    bool allPerfect = true;
+    std::cout << "maze:        " << cols << "x" << rows << " seed " << seed << "\n";
+    for(const std::string& name : algorithms) {
+        MazeGrid grid(cols, static_cast<int>(rows));
+        MazeGenerator* generator = (name == "chunked") ? new ChunkedGenerator(grid, seed, 256, threads) : createMazeGenerator(name, grid, seed);
+        if(!generator) {
+            std::cerr << "Error: unknown algorithm '" << name << "'\n";
+            return 1;
+        }
+        generator->run();
+
+        std::cout << "\n" << generator->getName() << "\n";
+        std::cout << "time:        " << generator->getElapsedSeconds() << " s\n";
+        std::cout << "throughput:  " << generator->getCellsPerSecond() << " cells/s\n";
+        std::cout << "grid memory: " << grid.memoryBytes() / 1024 << " KB\n";
+        if(name == "chunked") std::cout << "threads:     " << static_cast<ChunkedGenerator*>(generator)->getThreadCount() << "\n";
+        if(check) {
+            bool perfect = grid.isPerfect();
+            allPerfect = allPerfect && perfect;
+            std::cout << "perfect:     " << (perfect ? "yes" : "NO") << "\n";
+        }
+        // After --check, so its working memory is included.
+        std::cout << "peak memory: " << peakMemoryKB() << " KB\n";
+        delete generator;
+
+        if(!outPath.empty() && algorithms.size() == 1) {
+            std::ofstream out(outPath, std::ios::binary);
+            if(!out.is_open()) {
+                std::cerr << "Error: could not open " << outPath << "\n";
+                return 1;
+            }
+            if(format == "ascii") writeAscii(out, grid);
+            else writeBinary(out, grid, seed);
+            std::cout << "wrote:       " << outPath << "\n";
+        }
+    }
+    return allPerfect ? 0 : 1;
+}